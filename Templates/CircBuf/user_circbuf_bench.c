@@ -0,0 +1,699 @@
+/*
+ * user_circbuf_bench.c
+ *
+ * Host (Linux) throughput and latency benchmark of CircBuf and Msg32
+ *
+ * Build from the repository root (Templates/Platform/compiler_macros.h provides the Linux host branch):
+ *   gcc -O2 -pthread -ITemplates -Isrc -Isrc/CircBuf Templates/CircBuf/user_circbuf_bench.c \
+ *       src/CircBuf/CircBuf.c src/CircBuf/CircBuf32.c src/CircBuf/CircBufSpsc.c src/CircBuf/CircBufMpsc.c \
+ *       src/CircBuf/msg32.c src/CircBuf/msg32_mpmc.c Templates/Platform/user_sl_platform_linux.c -o circbuf_bench
+ *
+ * Output is CSV, the first column is the record type; the header row of each type precedes its records:
+ *   thr,<impl>,<buf_len>,<chunk>,<wrap>,<bytes>,<sec>,<mb_s>,<ops_s>
+ *   lat,<impl>,<lo_ns>,<hi_ns>,<count>
+ *   scal,<impl>,<pairs>,<msgs>,<sec>,<ops_s>
+ *   mpsc,<impl>,<producers>,<bytes>,<sec>,<mb_s>,<errors>
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "CircBuf/CircBuf.h"
+#include "CircBuf/CircBuf32.h"
+#include "CircBuf/CircBufSpsc.h"
+#include "CircBuf/CircBufMpsc.h"
+#include "CircBuf/msg32.h"
+#include "CircBuf/msg32_mpmc.h"
+
+
+#ifndef USER_CIRCBUF_BENCH_BYTES
+#define USER_CIRCBUF_BENCH_BYTES    (64u << 20)          // объём данных на один замер пропускной способности
+#endif
+
+#ifndef USER_CIRCBUF_BENCH_OPS
+#define USER_CIRCBUF_BENCH_OPS      (4u << 20)           // максимальное число операций на один замер
+#endif
+
+#ifndef USER_CIRCBUF_BENCH_XCORE_BYTES
+#define USER_CIRCBUF_BENCH_XCORE_BYTES (256u << 20)      // объём данных на замер передачи между потоками
+#endif
+
+#ifndef USER_CIRCBUF_BENCH_LAT_MSG
+#define USER_CIRCBUF_BENCH_LAT_MSG  200000u              // число сообщений на замер задержки
+#endif
+
+#ifndef USER_CIRCBUF_BENCH_MPMC_MSG
+#define USER_CIRCBUF_BENCH_MPMC_MSG (4u << 20)           // число сообщений на замер масштабирования MPMC
+#endif
+
+#ifndef USER_CIRCBUF_BENCH_MPMC_PAIRS
+#define USER_CIRCBUF_BENCH_MPMC_PAIRS 8                  // максимальное число пар писатель - читатель
+#endif
+
+#ifndef USER_CIRCBUF_BENCH_MPSC_REC
+#define USER_CIRCBUF_BENCH_MPSC_REC (2u << 20)           // число записей на замер нескольких писателей
+#endif
+
+#define USER_BENCH_MAX_CHUNK        (64u << 10)          // максимальный размер порции
+#define USER_BENCH_HIST_LEN         32                   // интервалы гистограммы задержки: [2^i, 2^(i+1)) нс
+#define USER_BENCH_LAT_BUF_LEN      4096                 // длина буфера при замере задержки
+#define USER_BENCH_MPSC_REC_LEN     16                   // длина записи при замере нескольких писателей
+
+
+static uint8_t bench_src[USER_BENCH_MAX_CHUNK];
+static uint8_t bench_dst[USER_BENCH_MAX_CHUNK];
+static uint8_t bench_buf[2 * USER_BENCH_MAX_CHUNK];
+
+static volatile uint32_t bench_sink;                     // не даёт компилятору удалить копирование
+
+
+// время в наносекундах
+static uint64_t USER_Bench_GetNs()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+
+// число операций замера для порции chunk
+static uint32_t USER_Bench_GetOps(uint32_t chunk)
+{
+	uint32_t ops = USER_CIRCBUF_BENCH_BYTES / chunk;
+
+	if(ops > USER_CIRCBUF_BENCH_OPS)
+		ops = USER_CIRCBUF_BENCH_OPS;
+
+	return ops;
+}
+
+
+// смещение индексов в режиме wrap: половина порции, но не меньше 1 байта
+// (порция в 1 байт границу пересечь не может, смещение лишь выводит индексы из нулевой позиции)
+static uint32_t USER_Bench_WrapOfs(uint32_t chunk)
+{
+	return (chunk + 1) / 2;
+}
+
+
+// вывести результат замера пропускной способности
+static void USER_Bench_PrintThr(const char *impl, uint32_t buf_len, uint32_t chunk, uint8_t wrap, uint32_t ops, uint64_t ns)
+{
+	double sec   = (double)ns / 1e9;
+	double bytes = (double)ops * chunk;
+
+	if(sec <= 0.0)
+		sec = 1e-9;
+
+	printf("thr,%s,%u,%u,%u,%.0f,%.6f,%.2f,%.0f\n", impl, buf_len, chunk, wrap, bytes, sec, bytes / sec / 1e6, ops / sec);
+}
+
+
+// CircBuf_AddData + CircBuf_ReadData порциями chunk
+// wrap = 1 - индексы смещены на половину порции (USER_Bench_WrapOfs), каждая порция за круг пересекает границу буфера
+static void USER_Bench_CircBuf(uint16_t buf_len, uint32_t chunk, uint8_t wrap)
+{
+	circ_buf_t cb;
+	circ_buf_init_t init = {0};
+	uint32_t ops = USER_Bench_GetOps(chunk);
+	uint64_t t0;
+
+	init.buf_ptr = bench_buf;
+	init.buf_len = buf_len;
+	CircBuf_Init(&cb, &init);
+
+	if(wrap)
+	{
+		CircBuf_AddData(&cb, bench_src, USER_Bench_WrapOfs(chunk));
+		CircBuf_Skip(&cb, USER_Bench_WrapOfs(chunk));
+	}
+
+	t0 = USER_Bench_GetNs();
+	for(uint32_t i = 0; i < ops; i++)
+	{
+		CircBuf_AddData(&cb, bench_src, chunk);
+		CircBuf_ReadData(&cb, bench_dst, chunk);
+	}
+	USER_Bench_PrintThr("circbuf", buf_len, chunk, wrap, ops, USER_Bench_GetNs() - t0);
+
+	bench_sink += bench_dst[0];
+}
+
+
+// CircBuf32_AddData + CircBuf32_ReadData порциями chunk (порции до 64 КБ)
+static void USER_Bench_CircBuf32(uint32_t buf_len, uint32_t chunk, uint8_t wrap)
+{
+	circ_buf32_t cb;
+	circ_buf32_init_t init = {0};
+	uint32_t ops = USER_Bench_GetOps(chunk);
+	uint64_t t0;
+
+	init.buf_ptr = bench_buf;
+	init.buf_len = buf_len;
+	CircBuf32_Init(&cb, &init);
+
+	if(wrap)
+	{
+		CircBuf32_AddData(&cb, bench_src, USER_Bench_WrapOfs(chunk));
+		CircBuf32_ReadData(&cb, bench_dst, USER_Bench_WrapOfs(chunk));
+	}
+
+	t0 = USER_Bench_GetNs();
+	for(uint32_t i = 0; i < ops; i++)
+	{
+		CircBuf32_AddData(&cb, bench_src, chunk);
+		CircBuf32_ReadData(&cb, bench_dst, chunk);
+	}
+	USER_Bench_PrintThr("circbuf32", buf_len, chunk, wrap, ops, USER_Bench_GetNs() - t0);
+
+	bench_sink += bench_dst[0];
+}
+
+
+// CircBuf_DataCopyBetweenIndexes для участка длиной chunk
+static void USER_Bench_CopyBetween(uint16_t buf_len, uint32_t chunk, uint8_t wrap)
+{
+	circ_buf_t cb;
+	circ_buf_init_t init = {0};
+	uint32_t ops = USER_Bench_GetOps(chunk);
+	uint16_t start_ind = wrap ? (buf_len - USER_Bench_WrapOfs(chunk)) : 0;
+	uint16_t end_ind;
+	uint64_t t0;
+
+	init.buf_ptr = bench_buf;
+	init.buf_len = buf_len;
+	CircBuf_Init(&cb, &init);
+	end_ind = CircBuf_AddIndValue(&cb, start_ind, chunk);
+
+	t0 = USER_Bench_GetNs();
+	for(uint32_t i = 0; i < ops; i++)
+		CircBuf_DataCopyBetweenIndexes(&cb, bench_dst, start_ind, end_ind);
+	USER_Bench_PrintThr("copy_between", buf_len, chunk, wrap, ops, USER_Bench_GetNs() - t0);
+
+	bench_sink += bench_dst[0];
+}
+
+
+// Msg32_WriteData + Msg32_ReadData, порция - одно слово
+static void USER_Bench_Msg32(uint16_t buf_size)
+{
+	msg32_t msg;
+	uint32_t data = 0;
+	uint32_t ops = USER_CIRCBUF_BENCH_OPS;
+	uint64_t t0;
+
+	Msg32_Initialize(&msg, (uint32_t*)bench_buf, buf_size);
+
+	t0 = USER_Bench_GetNs();
+	for(uint32_t i = 0; i < ops; i++)
+	{
+		Msg32_WriteData(&msg, i);
+		Msg32_ReadData(&msg, &data);
+	}
+	USER_Bench_PrintThr("msg32", buf_size, sizeof(uint32_t), 0, ops, USER_Bench_GetNs() - t0);
+
+	bench_sink += data;
+}
+
+
+// Msg32_WriteBatch + Msg32_ReadBatch, порция - n слов
+static void USER_Bench_Msg32Batch(uint16_t buf_size, uint16_t n)
+{
+	msg32_t msg;
+	uint32_t ops = USER_CIRCBUF_BENCH_OPS / n;
+	uint64_t t0;
+
+	Msg32_Initialize(&msg, (uint32_t*)bench_buf, buf_size);
+
+	t0 = USER_Bench_GetNs();
+	for(uint32_t i = 0; i < ops; i++)
+	{
+		Msg32_WriteBatch(&msg, (const uint32_t*)bench_src, n, NULL);
+		Msg32_ReadBatch(&msg, (uint32_t*)bench_dst, n, NULL);
+	}
+	USER_Bench_PrintThr("msg32_batch", buf_size, n * sizeof(uint32_t), 0, ops, USER_Bench_GetNs() - t0);
+
+	bench_sink += bench_dst[0];
+}
+
+
+// замер передачи между потоками (ядрами)
+typedef struct
+{
+	circ_buf_t cb;                        // буфер CircBuf (режим SPSC)
+	circ_buf_spsc_t spsc;                 // буфер CircBufSpsc (поля сторон в разных строках кэша)
+	uint8_t use_spsc;                     // 1 - замер CircBufSpsc
+	uint32_t chunk;                       // размер порции
+
+} user_bench_xcore_t;
+
+
+static uint8_t bench_xcore_src[USER_BENCH_MAX_CHUNK];
+
+
+// поток писателя
+static void* USER_Bench_XcoreProducer(void *arg)
+{
+	user_bench_xcore_t *p = arg;
+	circ_buf_error_code_t ret;
+
+	for(uint32_t sent = 0; sent < USER_CIRCBUF_BENCH_XCORE_BYTES; )
+	{
+		if(p->use_spsc)
+			ret = CircBufSpsc_AddData(&p->spsc, bench_xcore_src, p->chunk);
+		else
+			ret = CircBuf_AddData(&p->cb, bench_xcore_src, p->chunk);
+
+		if(ret == CIRC_BUF__OK)
+			sent += p->chunk;
+		else
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+
+// пропускная способность писатель - читатель в разных потоках
+static void USER_Bench_Xcore(uint8_t use_spsc, uint16_t buf_len, uint32_t chunk)
+{
+	static user_bench_xcore_t x;
+	circ_buf_init_t init = {0};
+	pthread_t thread;
+	uint32_t len;
+	uint64_t t0;
+
+	memset(&x, 0, sizeof(x));
+	x.use_spsc = use_spsc;
+	x.chunk = chunk;
+
+	init.buf_ptr = bench_buf;
+	init.buf_len = buf_len;
+	init.mode = CIRC_BUF_MODE_SPSC | CIRC_BUF_MODE_POW2;
+	CircBuf_Init(&x.cb, &init);
+	CircBufSpsc_Init(&x.spsc, bench_buf, buf_len);
+
+	t0 = USER_Bench_GetNs();
+
+	if(pthread_create(&thread, NULL, USER_Bench_XcoreProducer, &x) != 0)
+		return;
+
+	for(uint32_t recv = 0; recv < USER_CIRCBUF_BENCH_XCORE_BYTES; recv += len)
+	{
+		if(use_spsc)
+			len = CircBufSpsc_ReadData(&x.spsc, bench_dst, chunk);
+		else
+			len = CircBuf_ReadData(&x.cb, bench_dst, chunk);
+
+		if(len == 0)
+			sched_yield();
+	}
+
+	pthread_join(thread, NULL);
+
+	USER_Bench_PrintThr(use_spsc ? "xcore_circbuf_spsc_padded" : "xcore_circbuf_spsc", buf_len, chunk, 0,
+	                    USER_CIRCBUF_BENCH_XCORE_BYTES / chunk, USER_Bench_GetNs() - t0);
+}
+
+
+// замер нескольких писателей: записи {номер писателя, номер записи, ~номер записи, контрольная сумма}
+typedef struct
+{
+	circ_buf_t cb;                        // буфер CircBuf (CircBuf_AddDataProtected)
+	circ_buf_mpsc_t mpsc;                 // буфер CircBufMpsc
+	uint8_t use_mpsc;                     // 1 - замер CircBufMpsc
+	uint32_t per_thread;                  // записей на одного писателя
+	uint32_t id;                          // номер следующего писателя
+
+} user_bench_mpsc_t;
+
+
+static uint32_t bench_mpsc_buf[USER_BENCH_LAT_BUF_LEN / sizeof(uint32_t)];   // выровнен на 4 байта
+
+
+// поток писателя
+static void* USER_Bench_MpscProducer(void *arg)
+{
+	user_bench_mpsc_t *p = arg;
+	uint32_t rec[USER_BENCH_MPSC_REC_LEN / sizeof(uint32_t)];
+	circ_buf_error_code_t ret;
+
+	rec[0] = ATOMIC_ADD32(&p->id, 1);
+
+	for(uint32_t i = 0; i < p->per_thread; )
+	{
+		rec[1] = i;
+		rec[2] = ~i;
+		rec[3] = rec[0] ^ i;
+
+		if(p->use_mpsc)
+			ret = CircBufMpsc_AddData(&p->mpsc, (uint8_t*)rec, sizeof(rec));
+		else
+			ret = CircBuf_AddDataProtected(&p->cb, (uint8_t*)rec, sizeof(rec));
+
+		if(ret == CIRC_BUF__OK)
+			i++;
+		else
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+
+// пропускная способность и проверка потока при producers писателях и одном читателе
+static void USER_Bench_Mpsc(uint8_t use_mpsc, uint8_t producers)
+{
+	static user_bench_mpsc_t m;
+	pthread_t thread[USER_CIRCBUF_BENCH_MPMC_PAIRS];
+	uint32_t next[USER_CIRCBUF_BENCH_MPMC_PAIRS] = {0};   // ожидаемый номер записи каждого писателя
+	uint32_t rec[USER_BENCH_MPSC_REC_LEN / sizeof(uint32_t)];
+	circ_buf_init_t init = {0};
+	uint32_t errors = 0;
+	uint32_t total;
+	uint32_t len;
+	uint8_t started = 0;
+	uint64_t t0;
+	double sec;
+
+	memset(&m, 0, sizeof(m));
+	m.use_mpsc = use_mpsc;
+	m.per_thread = USER_CIRCBUF_BENCH_MPSC_REC / producers;
+	total = m.per_thread * producers;
+
+	init.buf_ptr = (uint8_t*)bench_mpsc_buf;
+	init.buf_len = sizeof(bench_mpsc_buf);
+	CircBuf_Init(&m.cb, &init);
+	CircBufMpsc_Init(&m.mpsc, (uint8_t*)bench_mpsc_buf, sizeof(bench_mpsc_buf));
+
+	t0 = USER_Bench_GetNs();
+
+	for(uint8_t i = 0; i < producers; i++)
+		if(pthread_create(&thread[started], NULL, USER_Bench_MpscProducer, &m) == 0)
+			started++;
+
+	if(started != producers)                              // без всех писателей читатель не дождётся данных
+		total = 0;
+
+	// запись каждого писателя приходит целиком, порядок записей одного писателя сохраняется
+	for(uint32_t n = 0; n < total; n++)
+	{
+		for(len = 0; len < sizeof(rec); )
+		{
+			if(use_mpsc)
+				len += CircBufMpsc_ReadData(&m.mpsc, (uint8_t*)rec + len, sizeof(rec) - len);
+			else
+				len += CircBuf_ReadData(&m.cb, (uint8_t*)rec + len, sizeof(rec) - len);
+
+			if(len < sizeof(rec))
+				sched_yield();
+		}
+
+		if((rec[0] >= producers) || (rec[1] != next[rec[0]]) || (rec[2] != ~rec[1]) || (rec[3] != (rec[0] ^ rec[1])))
+			errors++;
+		else
+			next[rec[0]]++;
+	}
+
+	for(uint8_t i = 0; i < started; i++)
+		pthread_join(thread[i], NULL);
+
+	sec = (double)(USER_Bench_GetNs() - t0) / 1e9;
+	if(sec <= 0.0)
+		sec = 1e-9;
+
+	printf("mpsc,%s,%u,%u,%.6f,%.2f,%u\n", use_mpsc ? "circbuf_mpsc" : "circbuf_protected", producers,
+	       total * USER_BENCH_MPSC_REC_LEN, sec, total * USER_BENCH_MPSC_REC_LEN / sec / 1e6, errors);
+}
+
+
+// замер масштабирования очереди сообщений: pairs писателей и pairs читателей
+typedef struct
+{
+	msg32_mpmc_t mpmc;                    // очередь Msg32Mpmc
+	msg32_t msg;                          // очередь Msg32 (защищённые функции)
+	uint8_t use_mpmc;                     // 1 - замер Msg32Mpmc
+	uint32_t per_thread;                  // сообщений на один поток
+
+} user_bench_mpmc_t;
+
+
+static msg32_mpmc_cell_t bench_mpmc_cell[USER_BENCH_LAT_BUF_LEN / sizeof(uint32_t)];
+static uint32_t bench_mpmc_msg_buf[USER_BENCH_LAT_BUF_LEN / sizeof(uint32_t)];
+
+
+// поток писателя
+static void* USER_Bench_MpmcProducer(void *arg)
+{
+	user_bench_mpmc_t *p = arg;
+	msg32_ret_t ret;
+
+	for(uint32_t i = 0; i < p->per_thread; )
+	{
+		if(p->use_mpmc)
+			ret = Msg32Mpmc_WriteData(&p->mpmc, i);
+		else
+			ret = Msg32_WriteDataProtected(&p->msg, i);
+
+		if(ret == MSG32__OK)
+			i++;
+		else
+			sched_yield();
+	}
+
+	return NULL;
+}
+
+
+// поток читателя
+static void* USER_Bench_MpmcConsumer(void *arg)
+{
+	user_bench_mpmc_t *p = arg;
+	uint32_t data = 0;
+	msg32_ret_t ret;
+
+	for(uint32_t i = 0; i < p->per_thread; )
+	{
+		if(p->use_mpmc)
+			ret = Msg32Mpmc_ReadData(&p->mpmc, &data);
+		else
+			ret = Msg32_WriteReadProtected(&p->msg, &data);
+
+		if(ret == MSG32__OK)
+			i++;
+		else
+			sched_yield();
+	}
+
+	bench_sink += data;
+
+	return NULL;
+}
+
+
+// пропускная способность очереди сообщений при числе пар писатель - читатель pairs
+static void USER_Bench_Mpmc(uint8_t use_mpmc, uint8_t pairs)
+{
+	static user_bench_mpmc_t m;
+	pthread_t thread[2 * USER_CIRCBUF_BENCH_MPMC_PAIRS];
+	uint32_t cell_num = sizeof(bench_mpmc_cell) / sizeof(bench_mpmc_cell[0]);
+	uint8_t started = 0;
+	uint64_t t0;
+	double sec;
+
+	memset(&m, 0, sizeof(m));
+	m.use_mpmc = use_mpmc;
+	m.per_thread = USER_CIRCBUF_BENCH_MPMC_MSG / pairs;
+
+	Msg32Mpmc_Initialize(&m.mpmc, bench_mpmc_cell, cell_num);
+	Msg32_Initialize(&m.msg, bench_mpmc_msg_buf, cell_num);
+
+	t0 = USER_Bench_GetNs();
+
+	for(uint8_t i = 0; i < pairs; i++)
+	{
+		if(pthread_create(&thread[started], NULL, USER_Bench_MpmcProducer, &m) == 0)
+			started++;
+		if(pthread_create(&thread[started], NULL, USER_Bench_MpmcConsumer, &m) == 0)
+			started++;
+	}
+
+	for(uint8_t i = 0; i < started; i++)
+		pthread_join(thread[i], NULL);
+
+	if(started != 2 * pairs)                              // без всех потоков замер не завершится корректно
+		return;
+
+	sec = (double)(USER_Bench_GetNs() - t0) / 1e9;
+	if(sec <= 0.0)
+		sec = 1e-9;
+
+	printf("scal,%s,%u,%u,%.6f,%.0f\n", use_mpmc ? "msg32_mpmc" : "msg32_protected", pairs,
+	       m.per_thread * pairs, sec, m.per_thread * pairs / sec);
+}
+
+
+// замер задержки: писатель передаёт метку времени, читатель строит гистограмму
+typedef struct
+{
+	circ_buf_t cb;                        // буфер CircBuf (режим SPSC)
+	msg32_t msg;                          // буфер Msg32 (защищённые функции)
+	uint8_t use_msg32;                    // 1 - замер Msg32
+
+	uint32_t hist[USER_BENCH_HIST_LEN];   // гистограмма задержки
+
+} user_bench_lat_t;
+
+
+static uint8_t  bench_lat_buf[USER_BENCH_LAT_BUF_LEN];
+static uint32_t bench_lat_msg_buf[USER_BENCH_LAT_BUF_LEN / sizeof(uint32_t)];
+
+
+// поток писателя
+static void* USER_Bench_LatProducer(void *arg)
+{
+	user_bench_lat_t *p = arg;
+	uint32_t ts;
+
+	for(uint32_t i = 0; i < USER_CIRCBUF_BENCH_LAT_MSG; i++)
+	{
+		ts = (uint32_t)USER_Bench_GetNs();
+
+		if(p->use_msg32)
+		{
+			while(Msg32_WriteDataProtected(&p->msg, ts) != MSG32__OK)
+				sched_yield();
+		}else
+		{
+			while(CircBuf_AddData(&p->cb, (uint8_t*)&ts, sizeof(ts)) != CIRC_BUF__OK)
+				sched_yield();
+		}
+	}
+
+	return NULL;
+}
+
+
+// замер задержки передачи между потоками
+static void USER_Bench_Latency(uint8_t use_msg32)
+{
+	static user_bench_lat_t lat;
+	circ_buf_init_t init = {0};
+	pthread_t thread;
+	uint32_t cnt = 0;
+	uint32_t ts;
+	uint32_t dt;
+	uint8_t  i;
+
+	memset(&lat, 0, sizeof(lat));
+	lat.use_msg32 = use_msg32;
+
+	init.buf_ptr = bench_lat_buf;
+	init.buf_len = USER_BENCH_LAT_BUF_LEN;
+	init.mode = CIRC_BUF_MODE_SPSC | CIRC_BUF_MODE_POW2;
+	CircBuf_Init(&lat.cb, &init);
+
+	Msg32_Initialize(&lat.msg, bench_lat_msg_buf, USER_BENCH_LAT_BUF_LEN / sizeof(uint32_t));
+
+	if(pthread_create(&thread, NULL, USER_Bench_LatProducer, &lat) != 0)
+		return;
+
+	while(cnt < USER_CIRCBUF_BENCH_LAT_MSG)
+	{
+		if(use_msg32)
+		{
+			if(Msg32_WriteReadProtected(&lat.msg, &ts) != MSG32__OK)
+				continue;
+		}else
+		{
+			if(CircBuf_GetDataLen(&lat.cb) < sizeof(ts))
+				continue;
+			CircBuf_ReadData(&lat.cb, (uint8_t*)&ts, sizeof(ts));
+		}
+
+		dt = (uint32_t)USER_Bench_GetNs() - ts;
+		for(i = 0; (i < USER_BENCH_HIST_LEN - 1) && (dt >> (i + 1)); i++);
+		lat.hist[i]++;
+		cnt++;
+	}
+
+	pthread_join(thread, NULL);
+
+	for(i = 0; i < USER_BENCH_HIST_LEN; i++)
+	{
+		if(lat.hist[i])
+			printf("lat,%s,%u,%u,%u\n", use_msg32 ? "msg32" : "circbuf_spsc", i ? (1u << i) : 0u, (2u << i) - 1u, lat.hist[i]);
+	}
+}
+
+
+int main()
+{
+	static const uint16_t circ_buf_len[] = {1024, 16384, 65535};
+	static const uint32_t circ_buf32_len[] = {4096, 2 * USER_BENCH_MAX_CHUNK};
+	static const uint16_t msg32_size[] = {16, 256, 4096};
+
+	for(uint32_t i = 0; i < sizeof(bench_src); i++)
+		bench_src[i] = (uint8_t)i;
+
+	// строка заголовка выводится перед записями своего типа
+	printf("type,impl,buf_len,chunk,wrap,bytes,sec,mb_s,ops_s\n");
+
+	for(uint8_t wrap = 0; wrap < 2; wrap++)
+	{
+		for(uint8_t b = 0; b < sizeof(circ_buf_len) / sizeof(circ_buf_len[0]); b++)
+		{
+			// ёмкость буфера buf_len - 1, порция не больше половины буфера
+			for(uint32_t chunk = 1; chunk <= circ_buf_len[b] / 2; chunk <<= 1)
+			{
+				USER_Bench_CircBuf(circ_buf_len[b], chunk, wrap);
+				USER_Bench_CopyBetween(circ_buf_len[b], chunk, wrap);
+			}
+		}
+
+		for(uint8_t b = 0; b < sizeof(circ_buf32_len) / sizeof(circ_buf32_len[0]); b++)
+		{
+			for(uint32_t chunk = 1; (chunk <= circ_buf32_len[b] / 2) && (chunk <= USER_BENCH_MAX_CHUNK); chunk <<= 1)
+				USER_Bench_CircBuf32(circ_buf32_len[b], chunk, wrap);
+		}
+	}
+
+	for(uint8_t b = 0; b < sizeof(msg32_size) / sizeof(msg32_size[0]); b++)
+	{
+		USER_Bench_Msg32(msg32_size[b]);
+
+		for(uint16_t n = 4; n <= msg32_size[b] / 2; n <<= 1)
+			USER_Bench_Msg32Batch(msg32_size[b], n);
+	}
+
+	for(uint32_t chunk = 16; chunk <= 1024; chunk <<= 2)
+	{
+		USER_Bench_Xcore(0, 4096, chunk);
+		USER_Bench_Xcore(1, 4096, chunk);
+	}
+
+	printf("type,impl,lo_ns,hi_ns,count\n");
+	USER_Bench_Latency(0);
+	USER_Bench_Latency(1);
+
+	printf("type,impl,pairs,msgs,sec,ops_s\n");
+	for(uint8_t pairs = 1; pairs <= USER_CIRCBUF_BENCH_MPMC_PAIRS; pairs <<= 1)
+	{
+		USER_Bench_Mpmc(0, pairs);
+		USER_Bench_Mpmc(1, pairs);
+	}
+
+	printf("type,impl,producers,bytes,sec,mb_s,errors\n");
+	for(uint8_t producers = 1; producers <= USER_CIRCBUF_BENCH_MPMC_PAIRS; producers <<= 1)
+	{
+		USER_Bench_Mpsc(0, producers);
+		USER_Bench_Mpsc(1, producers);
+	}
+
+	return 0;
+}
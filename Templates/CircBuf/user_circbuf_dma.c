@@ -0,0 +1,70 @@
+/*
+ * user_circbuf_dma.c
+ *
+ * Example of circular buffer fed by circular DMA of UART receiver
+ */
+
+
+#include "CircBuf/CircBuf.h"
+#include "main.h"
+
+#define USER_UART_RX_LEN  256                        // длина буфера приёма (чётная)
+
+uint8_t    uart_rx_buf[USER_UART_RX_LEN];
+circ_buf_t uart_rx_cb;
+
+
+// позиция записи DMA
+static uint16_t USER_UART_RxDmaPos()
+{
+	return USER_UART_RX_LEN - __HAL_DMA_GET_COUNTER(huart1.hdmarx);
+}
+
+
+// инициализация
+void USER_UART_RxInit()
+{
+	circ_buf_init_t init = {0};
+	init.buf_ptr = uart_rx_buf;
+	init.buf_len = USER_UART_RX_LEN;
+	init.mode = CIRC_BUF_MODE_DMA;
+	init.dma_pos_cbk = USER_UART_RxDmaPos;
+
+	CircBuf_Init(&uart_rx_cb, &init);
+
+	HAL_UART_Receive_DMA(&huart1, uart_rx_buf, USER_UART_RX_LEN);   // канал DMA в режиме Circular
+}
+
+
+// принята половина буфера
+void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef *huart)
+{
+	if(huart == &huart1)
+		CircBuf_DmaHalfCpltIrq(&uart_rx_cb);
+}
+
+
+// принят весь буфер
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+	if(huart == &huart1)
+		CircBuf_DmaCpltIrq(&uart_rx_cb);
+}
+
+
+// обработка принятых данных в основном цикле
+void USER_UART_RxProc()
+{
+	uint8_t  data[USER_UART_RX_LEN];
+	uint16_t len = CircBuf_GetDataLen(&uart_rx_cb);                   // синхронизация с позицией DMA
+	uint16_t start_ind = CircBuf_GetStartIndex(&uart_rx_cb);
+	uint16_t end_ind = CircBuf_AddIndValue(&uart_rx_cb, start_ind, len);
+
+	if(len == 0)
+		return;
+
+	CircBuf_DataCopyBetweenIndexes(&uart_rx_cb, data, start_ind, end_ind);
+	CircBuf_SetStartInd(&uart_rx_cb, end_ind);
+
+	// разбор data[0..len)
+}
@@ -0,0 +1,183 @@
+/*
+ * user_circbuf_dma_sim.c
+ *
+ * Host (Linux) simulation of circular DMA feeding CircBuf in CIRC_BUF_MODE_DMA
+ *
+ * The DMA channel is modelled by its NDTR counter: every transfer writes the next byte of a
+ * known stream at position buf_len - NDTR, NDTR counts down and reloads to buf_len at 0;
+ * half / complete interrupts are raised at NDTR == buf_len / 2 and at reload, with random latency.
+ * The reader does partial reads at random moments, the reconstructed stream is checked byte by byte.
+ * The second pass lets DMA overrun the reader and checks that overflow is detected and the stream resumes.
+ *
+ * Build from the repository root:
+ *   gcc -O2 -ITemplates -Isrc -Isrc/CircBuf Templates/CircBuf/user_circbuf_dma_sim.c src/CircBuf/CircBuf.c -o circbuf_dma_sim
+ *
+ * exit code 1 if the check failed
+ */
+
+
+#include <stdio.h>
+
+#include "CircBuf/CircBuf.h"
+
+
+#define USER_DMA_SIM_BUF_LEN     256                 // длина буфера (чётная)
+#define USER_DMA_SIM_STEPS       2000000             // число шагов модели
+#define USER_DMA_SIM_MAX_LAT     5                   // максимальная задержка прерывания, передач
+
+
+// модель канала DMA
+typedef struct
+{
+	uint16_t ndtr;                        // счётчик оставшихся передач
+	uint32_t seq;                         // номер следующего байта потока
+	uint8_t  irq_pending;                 // прерывания, ожидающие обработки
+	uint8_t  irq_lat;                     // передач до обработки прерываний
+
+} user_dma_sim_t;
+
+
+static uint8_t        dma_sim_buf[USER_DMA_SIM_BUF_LEN];
+static circ_buf_t     dma_sim_cb;
+static user_dma_sim_t dma_sim;
+static uint32_t       dma_sim_rnd = 1;
+
+
+// псевдослучайное число 0..max-1
+static uint32_t USER_DmaSim_Rand(uint32_t max)
+{
+	dma_sim_rnd = dma_sim_rnd * 1664525u + 1013904223u;
+	return (dma_sim_rnd >> 8) % max;
+}
+
+
+// позиция записи DMA по счётчику
+static uint16_t USER_DmaSim_Pos()
+{
+	return USER_DMA_SIM_BUF_LEN - dma_sim.ndtr;
+}
+
+
+// обработать отложенные прерывания
+static void USER_DmaSim_Irq()
+{
+	while(dma_sim.irq_pending)
+	{
+		dma_sim.irq_pending--;
+		CircBuf_DmaHalfCpltIrq(&dma_sim_cb);                    // обработчики половины и конца буфера одинаковы
+	}
+}
+
+
+// передать len байт потока
+static void USER_DmaSim_Transfer(uint32_t len)
+{
+	while(len--)
+	{
+		dma_sim_buf[USER_DmaSim_Pos()] = (uint8_t)dma_sim.seq++;
+
+		if(--dma_sim.ndtr == 0)
+			dma_sim.ndtr = USER_DMA_SIM_BUF_LEN;              // перезагрузка счётчика в режиме Circular
+
+		if((dma_sim.ndtr == USER_DMA_SIM_BUF_LEN / 2) || (dma_sim.ndtr == USER_DMA_SIM_BUF_LEN))
+		{
+			dma_sim.irq_pending++;
+			dma_sim.irq_lat = USER_DmaSim_Rand(USER_DMA_SIM_MAX_LAT + 1);
+		}
+
+		if(dma_sim.irq_pending && (dma_sim.irq_lat-- == 0))
+			USER_DmaSim_Irq();
+	}
+}
+
+
+// прогон модели, overrun = 1 - DMA периодически обгоняет читателя
+static uint32_t USER_DmaSim_Run(uint8_t overrun)
+{
+	circ_buf_init_t init = {0};
+	uint8_t  data[USER_DMA_SIM_BUF_LEN];
+	uint32_t exp_seq = 0;                 // ожидаемый номер следующего байта у читателя
+	uint32_t errors = 0;
+	uint32_t ovf_cnt = 0;
+	uint32_t ovf_exp = 0;
+	uint32_t adv;
+	uint16_t len;
+	uint16_t start_ind;
+
+	dma_sim.ndtr = USER_DMA_SIM_BUF_LEN;
+	dma_sim.seq = 0;
+	dma_sim.irq_pending = 0;
+
+	init.buf_ptr = dma_sim_buf;
+	init.buf_len = USER_DMA_SIM_BUF_LEN;
+	init.mode = CIRC_BUF_MODE_DMA;
+	init.dma_pos_cbk = USER_DmaSim_Pos;
+	CircBuf_Init(&dma_sim_cb, &init);
+
+	for(uint32_t step = 0; step < USER_DMA_SIM_STEPS; step++)
+	{
+		// DMA: без обгона не больше свободного места с учётом задержки прерываний
+		if(overrun && (USER_DmaSim_Rand(1000) == 0))
+		{
+			adv = USER_DMA_SIM_BUF_LEN + USER_DmaSim_Rand(2 * USER_DMA_SIM_BUF_LEN);
+			ovf_exp++;
+		}else
+		{
+			adv = USER_DMA_SIM_BUF_LEN - 1 - (dma_sim.seq - exp_seq);
+			adv = USER_DmaSim_Rand(adv / 4 + 1);
+		}
+
+		USER_DmaSim_Transfer(adv);
+
+		// читатель: частичное чтение, поочерёдно по индексам и через CircBuf_ReadData
+		ovf_cnt = dma_sim_cb.ovf_err_cnt;
+		len = CircBuf_GetDataLen(&dma_sim_cb);
+
+		if(dma_sim_cb.ovf_err_cnt != ovf_cnt)
+		{
+			exp_seq = dma_sim.seq;                              // данные буфера отброшены, поток продолжается с позиции DMA
+			continue;
+		}
+
+		len = USER_DmaSim_Rand(len + 1);
+		if(len == 0)
+			continue;
+
+		if(step & 1)
+		{
+			start_ind = CircBuf_GetStartIndex(&dma_sim_cb);
+			CircBuf_DataCopyBetweenIndexes(&dma_sim_cb, data, start_ind, CircBuf_AddIndValue(&dma_sim_cb, start_ind, len));
+			CircBuf_SetStartInd(&dma_sim_cb, CircBuf_AddIndValue(&dma_sim_cb, start_ind, len));
+		}else
+		{
+			len = CircBuf_ReadData(&dma_sim_cb, data, len);
+		}
+
+		for(uint16_t i = 0; i < len; i++)
+			if(data[i] != (uint8_t)(exp_seq + i))
+				errors++;
+
+		exp_seq += len;
+	}
+
+	if(dma_sim_cb.ovf_err_cnt != ovf_exp)
+		errors++;
+
+	printf("dma_sim,%s,%u,%u,%u,%u\n", overrun ? "overrun" : "normal", USER_DMA_SIM_STEPS, exp_seq,
+	       (unsigned)dma_sim_cb.ovf_err_cnt, errors);
+
+	return errors;
+}
+
+
+int main()
+{
+	uint32_t errors = 0;
+
+	printf("type,pass,steps,bytes,ovf,errors\n");
+
+	errors += USER_DmaSim_Run(0);
+	errors += USER_DmaSim_Run(1);
+
+	return (errors == 0) ? 0 : 1;
+}
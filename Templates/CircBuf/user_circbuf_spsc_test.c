@@ -0,0 +1,160 @@
+/*
+ * user_circbuf_spsc_test.c
+ *
+ * Host (Linux) stress test of CircBuf with one writer and one reader thread:
+ * the stream is checked byte by byte, throughput of CIRC_BUF_MODE_SPSC is compared
+ * with the default mode (data_size under ENTER_CRITICAL)
+ *
+ * Build from the repository root:
+ *   gcc -O2 -pthread -ITemplates -Isrc -Isrc/CircBuf Templates/CircBuf/user_circbuf_spsc_test.c \
+ *       src/CircBuf/CircBuf.c -o circbuf_spsc_test
+ *
+ * Output is CSV:
+ *   spsc,<impl>,<buf_len>,<bytes>,<sec>,<mb_s>,<errors>
+ * exit code 1 if any mismatch was found
+ */
+
+
+#include <stdio.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+
+#include "CircBuf/CircBuf.h"
+
+
+#ifndef USER_CIRCBUF_SPSC_TEST_BYTES
+#define USER_CIRCBUF_SPSC_TEST_BYTES  (64u << 20)        // объём данных на один прогон
+#endif
+
+#define USER_SPSC_TEST_MAX_CHUNK      61                 // максимальная порция записи / чтения (не кратна длине буфера)
+
+
+// прогон писатель - читатель
+typedef struct
+{
+	circ_buf_t cb;                        // проверяемый буфер
+	uint8_t buf[1024];                    // память буфера
+
+	uint32_t errors;                      // число несовпадений потока
+
+} user_spsc_test_t;
+
+
+static user_spsc_test_t spsc_test;
+
+
+// время в наносекундах
+static uint64_t USER_SpscTest_GetNs()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+
+// следующий размер порции 1..USER_SPSC_TEST_MAX_CHUNK
+static uint16_t USER_SpscTest_NextChunk(uint32_t *rnd)
+{
+	*rnd = *rnd * 1664525u + 1013904223u;
+	return (uint16_t)(1 + (*rnd >> 16) % USER_SPSC_TEST_MAX_CHUNK);
+}
+
+
+// поток писателя: байт потока - младший байт его порядкового номера
+static void* USER_SpscTest_Producer(void *arg)
+{
+	user_spsc_test_t *p = arg;
+	uint8_t chunk[USER_SPSC_TEST_MAX_CHUNK];
+	uint32_t seq = 0;
+	uint32_t rnd = 1;
+	uint16_t len;
+
+	while(seq < USER_CIRCBUF_SPSC_TEST_BYTES)
+	{
+		len = USER_SpscTest_NextChunk(&rnd);
+		if(len > USER_CIRCBUF_SPSC_TEST_BYTES - seq)
+			len = USER_CIRCBUF_SPSC_TEST_BYTES - seq;
+
+		for(uint16_t i = 0; i < len; i++)
+			chunk[i] = (uint8_t)(seq + i);
+
+		while(CircBuf_AddDataProtected(&p->cb, chunk, len) != CIRC_BUF__OK)  // буфер полон: ждать читателя
+			sched_yield();
+
+		seq += len;
+	}
+
+	return NULL;
+}
+
+
+// прогон: mode - флаги CIRC_BUF_MODE_..., читатель работает в вызывающем потоке
+static uint32_t USER_SpscTest_Run(const char *impl, uint8_t mode, uint16_t buf_len)
+{
+	user_spsc_test_t *p = &spsc_test;
+	circ_buf_init_t init = {0};
+	uint8_t chunk[USER_SPSC_TEST_MAX_CHUNK];
+	pthread_t thread;
+	uint32_t seq = 0;
+	uint32_t rnd = 7;
+	uint16_t len;
+	uint64_t t0;
+	double sec;
+
+	p->errors = 0;
+
+	init.buf_ptr = p->buf;
+	init.buf_len = buf_len;
+	init.mode = mode;
+	if(CircBuf_Init(&p->cb, &init) != CIRC_BUF__OK)
+		return 1;
+
+	t0 = USER_SpscTest_GetNs();
+
+	if(pthread_create(&thread, NULL, USER_SpscTest_Producer, p) != 0)
+		return 1;
+
+	while(seq < USER_CIRCBUF_SPSC_TEST_BYTES)
+	{
+		len = CircBuf_ReadData(&p->cb, chunk, USER_SpscTest_NextChunk(&rnd));
+		if(len == 0)
+		{
+			sched_yield();
+			continue;
+		}
+
+		for(uint16_t i = 0; i < len; i++)
+			if(chunk[i] != (uint8_t)(seq + i))
+				p->errors++;
+
+		seq += len;
+	}
+
+	pthread_join(thread, NULL);
+
+	sec = (double)(USER_SpscTest_GetNs() - t0) / 1e9;
+	if(sec <= 0.0)
+		sec = 1e-9;
+
+	printf("spsc,%s,%u,%u,%.6f,%.2f,%u\n", impl, buf_len, seq, sec, seq / sec / 1e6, p->errors);
+
+	return p->errors;
+}
+
+
+int main()
+{
+	uint32_t errors = 0;
+
+	printf("type,impl,buf_len,bytes,sec,mb_s,errors\n");
+
+	errors += USER_SpscTest_Run("critical", 0, 1000);
+	errors += USER_SpscTest_Run("spsc", CIRC_BUF_MODE_SPSC, 1000);
+	errors += USER_SpscTest_Run("critical_pow2", CIRC_BUF_MODE_POW2, 1024);
+	errors += USER_SpscTest_Run("spsc_pow2", CIRC_BUF_MODE_SPSC | CIRC_BUF_MODE_POW2, 1024);
+	errors += USER_SpscTest_Run("spsc_pow2", CIRC_BUF_MODE_SPSC | CIRC_BUF_MODE_POW2, 64);
+
+	return (errors == 0) ? 0 : 1;
+}
@@ -0,0 +1,77 @@
+/*
+ * user_msg32_prio_test.c
+ *
+ * Host check of the Msg32Prio starvation guard: every level keeps receiving data,
+ * the reader must still serve every level, not only the top and the lowest one
+ *
+ * Build from the repository root:
+ *   gcc -O2 -ITemplates -Isrc -Isrc/CircBuf Templates/CircBuf/user_msg32_prio_test.c \
+ *       src/CircBuf/msg32_prio.c src/CircBuf/msg32.c src/Platform/sl_platform.c -o msg32_prio_test
+ *
+ * Output is CSV:
+ *   prio,<levels>,<starve_limit>,<level>,<served>,<starve_cnt>
+ * exit code 1 if some level was never served
+ */
+
+
+#include <stdio.h>
+
+#include "CircBuf/msg32_prio.h"
+
+
+#define USER_PRIO_TEST_LEVELS    8                   // максимальное число уровней
+#define USER_PRIO_TEST_BUF_SIZE  8                   // длина очереди уровня
+#define USER_PRIO_TEST_READS     10000               // число чтений на прогон
+
+
+static msg32_prio_level_t prio_test_level[USER_PRIO_TEST_LEVELS];
+static uint32_t           prio_test_buf[USER_PRIO_TEST_LEVELS][USER_PRIO_TEST_BUF_SIZE];
+
+
+// прогон: перед каждым чтением во все уровни пишется по сообщению, возвращает число необслуженных уровней
+static uint32_t USER_PrioTest_Run(uint8_t level_num, uint16_t starve_limit)
+{
+	msg32_prio_t q;
+	uint32_t served[USER_PRIO_TEST_LEVELS] = {0};
+	uint32_t starved = 0;
+	uint32_t data;
+	uint8_t  level;
+
+	Msg32Prio_Initialize(&q, prio_test_level, level_num, starve_limit);
+	for(uint8_t i = 0; i < level_num; i++)
+		Msg32Prio_InitializeLevel(&q, i, prio_test_buf[i], USER_PRIO_TEST_BUF_SIZE);
+
+	for(uint32_t r = 0; r < USER_PRIO_TEST_READS; r++)
+	{
+		for(uint8_t i = 0; i < level_num; i++)
+			Msg32Prio_WriteData(&q, i, r);                // полный уровень отклоняет запись (ovf_cnt)
+
+		if(Msg32Prio_ReadData(&q, &data, &level) == MSG32__OK)
+			served[level]++;
+	}
+
+	for(uint8_t i = 0; i < level_num; i++)
+	{
+		printf("prio,%u,%u,%u,%u,%u\n", level_num, starve_limit, i, served[i], prio_test_level[i].starve_cnt);
+
+		if(served[i] == 0)
+			starved++;
+	}
+
+	return starved;
+}
+
+
+int main()
+{
+	uint32_t starved = 0;
+
+	printf("type,levels,starve_limit,level,served,starve_cnt\n");
+
+	starved += USER_PrioTest_Run(3, 1);
+	starved += USER_PrioTest_Run(3, 4);
+	starved += USER_PrioTest_Run(5, 3);
+	starved += USER_PrioTest_Run(USER_PRIO_TEST_LEVELS, 2);
+
+	return (starved == 0) ? 0 : 1;
+}
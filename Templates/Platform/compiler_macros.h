@@ -18,6 +18,7 @@
 
 #if defined ( __ICCARM__ ) // IAR
 
+	#include <stdint.h>
 	#include <intrinsics.h>
 
 	#define ENTER_CRITICAL(x)     x=__get_interrupt_state(); __disable_interrupt()
@@ -36,15 +37,127 @@
 
 	#define NOP()                __no_operation()
 
+	#define MEM_BARRIER()        __DMB()
+
+	#define ATOMIC_CAS32(p, e, d) IAR_AtomicCas32((p), (e), (d))   // 1 - *p был равен e и заменён на d
+	#define ATOMIC_ADD32(p, v)    IAR_AtomicAdd32((p), (v))        // возвращает прежнее значение
+
+	#define CLZ32(x)             __CLZ(x)                          // число старших нулевых бит, CLZ32(0) = 32
+
 	#define SFINLINE             static inline
 
 	#define IAR_COMPILER
 
+	SFINLINE uint32_t IAR_AtomicCas32(volatile uint32_t *p, uint32_t e, uint32_t d)
+	{
+		do
+		{
+			if(__LDREX((unsigned long*)p) != e)
+			{
+				__CLREX();
+				return 0;
+			}
+		}while(__STREX(d, (unsigned long*)p));
+		__DMB();
+		return 1;
+	}
+
+	SFINLINE uint32_t IAR_AtomicAdd32(volatile uint32_t *p, uint32_t v)
+	{
+		uint32_t old;
+		do
+		{
+			old = __LDREX((unsigned long*)p);
+		}while(__STREX(old + v, (unsigned long*)p));
+		__DMB();
+		return old;
+	}
+
 #elif defined (__CC_ARM) // KEIL
 
+	#include <stdint.h>
+
 	#define ENTER_CRITICAL(x)     x=__disable_irq()
 	#define LEAVE_CRITICAL(x)     if (!x) __enable_irq()
 
+	#define MEM_BARRIER()         __dmb(0xF)
+
+	#define ATOMIC_CAS32(p, e, d) KEIL_AtomicCas32((p), (e), (d))  // 1 - *p был равен e и заменён на d
+	#define ATOMIC_ADD32(p, v)    KEIL_AtomicAdd32((p), (v))       // возвращает прежнее значение
+
+	#define CLZ32(x)              __clz(x)                         // число старших нулевых бит, CLZ32(0) = 32
+
+	#define SFINLINE              static __forceinline
+
+	#define KEIL_COMPILER
+
+	SFINLINE uint32_t KEIL_AtomicCas32(volatile uint32_t *p, uint32_t e, uint32_t d)
+	{
+		do
+		{
+			if(__ldrex(p) != e)
+			{
+				__clrex();
+				return 0;
+			}
+		}while(__strex(d, p));
+		__dmb(0xF);
+		return 1;
+	}
+
+	SFINLINE uint32_t KEIL_AtomicAdd32(volatile uint32_t *p, uint32_t v)
+	{
+		uint32_t old;
+		do
+		{
+			old = __ldrex(p);
+		}while(__strex(old + v, p));
+		__dmb(0xF);
+		return old;
+	}
+
+#elif defined (__GNUC__) && defined (__linux__) // GCC, Linux host (benchmarks, CircBufMirror)
+
+	#include <stdint.h>
+	#include <sched.h>
+
+	#define __weak __attribute__((weak))
+
+	#define ENTER_CRITICAL(x)     x = 0; Host_EnterCritical()
+	#define LEAVE_CRITICAL(x)     (void)x; Host_LeaveCritical()
+
+	#define NOP()                __asm__ volatile("" ::: "memory")
+
+	#define MEM_BARRIER()        __sync_synchronize()
+
+	#define ATOMIC_CAS32(p, e, d) __sync_bool_compare_and_swap((p), (e), (d))   // 1 - *p был равен e и заменён на d
+	#define ATOMIC_ADD32(p, v)    __sync_fetch_and_add((p), (v))                // возвращает прежнее значение
+
+	#define CLZ32(x)             ((x) ? (uint32_t)__builtin_clz(x) : 32U)      // число старших нулевых бит, CLZ32(0) = 32
+
+	#define SFINLINE             static inline __attribute__((always_inline))
+
+	#define GCC_COMPILER
+	#define HOST_COMPILER
+
+	// критическая секция - общая для всех потоков блокировка с учётом вложенности
+	// (слабые определения объединяются компоновщиком в одну переменную)
+	__attribute__((weak)) volatile uint32_t host_crit_lock;
+	__attribute__((weak)) __thread uint32_t host_crit_depth;
+
+	SFINLINE void Host_EnterCritical()
+	{
+		if(host_crit_depth++ == 0)
+			while(__sync_lock_test_and_set(&host_crit_lock, 1))
+				sched_yield();
+	}
+
+	SFINLINE void Host_LeaveCritical()
+	{
+		if(--host_crit_depth == 0)
+			__sync_lock_release(&host_crit_lock);
+	}
+
 #elif defined (__GNUC__) //GCC
 
 	#include <stdint.h>
@@ -68,6 +181,13 @@
 
 	#define NOP()                __NOP()
 
+	#define MEM_BARRIER()        __DMB()
+
+	#define ATOMIC_CAS32(p, e, d) __sync_bool_compare_and_swap((p), (e), (d))   // 1 - *p был равен e и заменён на d
+	#define ATOMIC_ADD32(p, v)    __sync_fetch_and_add((p), (v))                // возвращает прежнее значение
+
+	#define CLZ32(x)             __CLZ(x)                                      // число старших нулевых бит, CLZ32(0) = 32
+
 	#define SFINLINE             __STATIC_FORCEINLINE
 
 	#define GCC_COMPILER
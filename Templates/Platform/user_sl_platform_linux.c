@@ -0,0 +1,92 @@
+/*
+ * user_sl_platform_linux.c
+ *
+ * Example of realizations of platform dependent functions for Linux host (tests, benchmarks)
+ *
+ * SL_WaitEvent / SL_SignalEvent are built on one pthread mutex + condition variable:
+ * the signaling side takes the mutex after the event counter is changed, so a waiter
+ * that has checked the counter under the mutex can not miss the broadcast.
+ * On RTOS targets the same pair maps to a binary semaphore / task notification.
+ */
+
+
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
+
+#include "Platform/sl_platform.h"
+
+
+static pthread_mutex_t sl_event_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  sl_event_cond  = PTHREAD_COND_INITIALIZER;
+
+
+static uint64_t SL_Host_GetTime_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+
+uint32_t SL_GetTick()
+{
+	return (uint32_t)(SL_Host_GetTime_ns() / 1000000ull);
+}
+
+
+void SL_Delay(uint32_t ms)
+{
+	struct timespec ts;
+
+	ts.tv_sec  = ms / 1000;
+	ts.tv_nsec = (long)(ms % 1000) * 1000000l;
+	while(nanosleep(&ts, &ts) == -1 && errno == EINTR);
+}
+
+
+uint32_t SL_GetTick_us()
+{
+	return (uint32_t)(SL_Host_GetTime_ns() / 1000ull);
+}
+
+
+uint8_t SL_WaitEvent(volatile uint32_t *seq, uint32_t val, uint32_t timeout_ms)
+{
+	struct timespec ts;
+	int res = 0;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	ts.tv_sec  += timeout_ms / 1000;
+	ts.tv_nsec += (long)(timeout_ms % 1000) * 1000000l;
+	if(ts.tv_nsec >= 1000000000l)
+	{
+		ts.tv_sec++;
+		ts.tv_nsec -= 1000000000l;
+	}
+
+	pthread_mutex_lock(&sl_event_mutex);
+
+	while((*seq == val) && (res != ETIMEDOUT))
+	{
+		if(timeout_ms == 0xFFFFFFFF)
+			pthread_cond_wait(&sl_event_cond, &sl_event_mutex);
+		else
+			res = pthread_cond_timedwait(&sl_event_cond, &sl_event_mutex, &ts);
+	}
+
+	pthread_mutex_unlock(&sl_event_mutex);
+
+	return (*seq != val);
+}
+
+
+void SL_SignalEvent(volatile uint32_t *seq)
+{
+	(void)seq;
+
+	pthread_mutex_lock(&sl_event_mutex);     // waiter is either before its check or inside cond_wait
+	pthread_mutex_unlock(&sl_event_mutex);
+	pthread_cond_broadcast(&sl_event_cond);
+}
@@ -27,15 +27,110 @@
 // безопасная работа с переменной data_size
 static void Private_CircBuf_AddDataSizeValue(circ_buf_t *ptr, int16_t add);
 
+// прочитать индекс, опубликованный другой стороной (acquire)
+static uint16_t Private_CircBuf_LoadInd(uint16_t *ind);
+
+// опубликовать индекс для другой стороны (release)
+static void Private_CircBuf_StoreInd(uint16_t *ind, uint16_t val);
+
+// число данных, вычисленное по индексам (режим CIRC_BUF_MODE_SPSC)
+static uint16_t Private_CircBuf_GetIndDataLen(circ_buf_t *ptr);
+
+// свободное место в буфере при заданном заполнении
+static uint16_t Private_CircBuf_GetFreeLen(circ_buf_t *ptr, uint16_t data_size);
+
+// сместить хранимый индекс на значение не больше длины буфера
+static uint16_t Private_CircBuf_AddInd(circ_buf_t *ptr, uint16_t ind, uint16_t add);
+
+// синхронизация с позицией DMA (режим CIRC_BUF_MODE_DMA)
+static uint16_t Private_CircBuf_DmaSync(circ_buf_t *ptr);
+
+// добавить записанные данные: сместить конечный индекс и обновить кол-во данных
+static void Private_CircBuf_PushData(circ_buf_t *ptr, uint16_t len);
+
+// удалить прочитанные данные: сместить стартовый индекс и обновить кол-во данных
+static void Private_CircBuf_PopData(circ_buf_t *ptr, uint16_t len);
+
+// разбить len байт начиная с позиции pos на участки до и после границы буфера
+static uint8_t Private_CircBuf_FillSegs(circ_buf_t *ptr, circ_buf_seg_t *seg, uint16_t pos, uint16_t len);
+
+// скопировать len байт из буфера начиная с индекса
+static void Private_CircBuf_CopyOut(circ_buf_t *ptr, uint8_t *dst, uint16_t ind, uint16_t len);
+
+// инициализация, mirror = 1 устанавливает CIRC_BUF_MODE_MIRROR (вызывается из CircBufMirror.c)
+circ_buf_error_code_t Private_CircBuf_Init(circ_buf_t *ptr, circ_buf_init_t *init, uint8_t mirror);
+
+// вытеснить старые данные, чтобы освободить место под len байт (режим CIRC_BUF_MODE_OVERWRITE)
+static void Private_CircBuf_DiscardOld(circ_buf_t *ptr, uint16_t len);
+
+// прочитать данные с учётом вытеснения писателем (режим CIRC_BUF_MODE_OVERWRITE)
+static uint16_t Private_CircBuf_OvrReadData(circ_buf_t *ptr, uint8_t *dst, uint16_t max_len);
+
+// проверить пересечение порогов заполнения и вызвать или отложить callback
+// side - события, которые может вызвать вызывающая сторона (учитывается в режиме CIRC_BUF_MODE_SPSC)
+static void Private_CircBuf_WmCheck(circ_buf_t *ptr, uint8_t side);
+
+// вызвать callback событий порогов
+static void Private_CircBuf_WmCall(circ_buf_t *ptr, uint8_t evt);
+
+// найти байт среди len байт данных начиная со смещения from
+static circ_buf_error_code_t Private_CircBuf_FindByte(circ_buf_t *ptr, uint8_t val, uint16_t len, uint16_t from, uint16_t *offset);
+
+// сравнить данные по смещению от начала данных с последовательностью
+static int Private_CircBuf_Compare(circ_buf_t *ptr, uint16_t offset, const uint8_t *pattern, uint16_t pattern_len);
+
 
 // инициализация
-void CircBuf_Init(circ_buf_t *ptr, circ_buf_init_t *init)
+circ_buf_error_code_t CircBuf_Init(circ_buf_t *ptr, circ_buf_init_t *init)
+{
+  return Private_CircBuf_Init(ptr, init, 0);
+}
+
+
+// инициализация, mirror = 1 - только для CircBufMirror_Init после построения двойного отображения
+circ_buf_error_code_t Private_CircBuf_Init(circ_buf_t *ptr, circ_buf_init_t *init, uint8_t mirror)
 {
   if((ptr == NULL) || (init == NULL))
-    return;
+    return CIRC_BUF__NULL_POINTER;
+
+  // неинициализированное поле mode (структура заполнена не целиком), CIRC_BUF_MODE_MIRROR
+  // через init не задаётся: на обычном массиве непрерывные участки выходят за его границу
+  if(init->mode & ~CIRC_BUF_MODE_ALL)
+    return CIRC_BUF__WRONG_ARG;
+
+  // длина должна быть степенью двойки
+  if(init->mode & CIRC_BUF_MODE_POW2)
+  {
+    if((init->buf_len == 0) || (init->buf_len & (init->buf_len - 1)))
+      return CIRC_BUF__WRONG_ARG;
+  }
+
+  // писателем является DMA, длина чётная для прерывания половины буфера
+  if(init->mode & CIRC_BUF_MODE_DMA)
+  {
+    if(init->mode & (CIRC_BUF_MODE_SPSC | CIRC_BUF_MODE_POW2))
+      return CIRC_BUF__WRONG_ARG;
+    if(init->dma_pos_cbk == NULL)
+      return CIRC_BUF__NULL_POINTER;
+    if((init->buf_len == 0) || (init->buf_len & 1))
+      return CIRC_BUF__WRONG_ARG;
+  }
+
+  // вытеснение смещает стартовый индекс со стороны писателя
+  if(init->mode & CIRC_BUF_MODE_OVERWRITE)
+  {
+    if(init->mode & (CIRC_BUF_MODE_SPSC | CIRC_BUF_MODE_DMA))
+      return CIRC_BUF__WRONG_ARG;
+  }
 
   ptr->buf_ptr = init->buf_ptr;
   ptr->buf_len = init->buf_len;
+  ptr->mode = init->mode | (mirror ? CIRC_BUF_MODE_MIRROR : 0);
+
+  if(ptr->mode & CIRC_BUF_MODE_POW2)
+    ptr->ind_mask = ptr->buf_len - 1;
+  else
+    ptr->ind_mask = 0xFFFF;                                                     // индексы всегда меньше длины, маска ничего не меняет
 
   ptr->start_ind = 0;
   ptr->end_ind = 0;
@@ -43,6 +138,16 @@ void CircBuf_Init(circ_buf_t *ptr, circ_buf_init_t *init)
 
   ptr->ovf_err_cnt = 0;
   ptr->lost_bytes = 0;
+  ptr->ovr_bytes = 0;
+
+  ptr->dma.pos_cbk = init->dma_pos_cbk;
+  ptr->dma.evt_cbk = init->dma_evt_cbk;
+  ptr->dma.evt_cnt = 0;
+  ptr->dma.evt_exp = 0;
+
+  memset(&ptr->wm, 0, sizeof(circ_buf_wm_t));
+
+  return CIRC_BUF__OK;
 }
 
 
@@ -62,6 +167,12 @@ uint16_t CircBuf_GetDataLen(circ_buf_t *ptr)
   if(ptr == NULL)
     return 0;
 
+  if(ptr->mode & CIRC_BUF_MODE_SPSC)
+    return Private_CircBuf_GetIndDataLen(ptr);
+
+  if(ptr->mode & CIRC_BUF_MODE_DMA)
+    return Private_CircBuf_DmaSync(ptr);
+
   return ptr->data_size;
 }
 
@@ -72,7 +183,17 @@ uint16_t CircBuf_GetStartIndex(circ_buf_t *ptr)
   if(ptr == NULL)
     return 0;
 
-  return ptr->start_ind;
+  return ptr->start_ind & ptr->ind_mask;
+}
+
+
+// получить свободное место в буфере
+uint16_t CircBuf_GetFreeLen(circ_buf_t *ptr)
+{
+	if(ptr == NULL)
+		return 0;
+
+	return Private_CircBuf_GetFreeLen(ptr, CircBuf_GetDataLen(ptr));
 }
 
 
@@ -110,6 +231,8 @@ uint16_t* CircBuf_GetStartIndexPtr(circ_buf_t *ptr)
 circ_buf_error_code_t CircBuf_AddData(circ_buf_t *ptr, uint8_t* data, uint16_t len)
 {
 	uint16_t len_to_border;
+	uint16_t data_size;
+	uint16_t pos;
 
 	if((ptr == NULL) || (data == NULL))
 		return CIRC_BUF__NULL_POINTER;
@@ -117,8 +240,32 @@ circ_buf_error_code_t CircBuf_AddData(circ_buf_t *ptr, uint8_t* data, uint16_t l
 	if(len == 0)
 		return CIRC_BUF__WRONG_ARG;
 
+	if(ptr->mode & CIRC_BUF_MODE_DMA)                                           // пишет только DMA
+		return CIRC_BUF__WRONG_ARG;
+
+	if(ptr->mode & CIRC_BUF_MODE_SPSC)
+		data_size = Private_CircBuf_GetIndDataLen(ptr);                         // заполнение по опубликованному читателем индексу
+	else
+		data_size = ptr->data_size;
+
+	// в режиме вытеснения освобождаем место за счёт самых старых данных
+	if((ptr->mode & CIRC_BUF_MODE_OVERWRITE) && (len > Private_CircBuf_GetFreeLen(ptr, data_size)))
+	{
+		uint16_t max_len = Private_CircBuf_GetFreeLen(ptr, 0);
+
+		// если новые данные больше буфера, сохраняем только их конец
+		if(len > max_len)
+		{
+			ptr->lost_bytes += len - max_len;
+			data = &data[len - max_len];
+			len = max_len;
+		}
+
+		Private_CircBuf_DiscardOld(ptr, len);
+	}
+
 	// проверка на переполение буфера
-	if(len >= (ptr->buf_len - ptr->data_size))
+	else if(len > Private_CircBuf_GetFreeLen(ptr, data_size))
 	{
 		ptr->ovf_err_cnt++;
 		ptr->lost_bytes += len;
@@ -126,25 +273,22 @@ circ_buf_error_code_t CircBuf_AddData(circ_buf_t *ptr, uint8_t* data, uint16_t l
 		return CIRC_BUF__OVF;
 	}
 
-	len_to_border = ptr->buf_len - ptr->end_ind;                                // расстояние до границы буфера
+	pos = ptr->end_ind & ptr->ind_mask;                                         // позиция записи в буфере
+	len_to_border = ptr->buf_len - pos;                                         // расстояние до границы буфера
 
-	// если данные не пересекают границу
-	if(len <= len_to_border)
+	// если данные не пересекают границу или за границей отображена копия буфера
+	if((len <= len_to_border) || (ptr->mode & CIRC_BUF_MODE_MIRROR))
 	{
-		memcpy(&ptr->buf_ptr[ptr->end_ind], data, len);                         // копируем данные
-		ptr->end_ind += len;                                                    // смещаем индек конца
-
-		// проверка закольцовки
-		if(ptr->end_ind >= ptr->buf_len)                                        // если перешли границу
-			ptr->end_ind = 0;                                                   // кольцуем
+		memcpy(&ptr->buf_ptr[pos], data, len);                                  // копируем данные
 	}else                                                                       // если данные пересекают границу
 	{
-		memcpy(&ptr->buf_ptr[ptr->end_ind], data, len_to_border);               // копируем до границы
+		memcpy(&ptr->buf_ptr[pos], data, len_to_border);                        // копируем до границы
 		memcpy(&ptr->buf_ptr[0], &data[len_to_border], len - len_to_border);    // копируем оставшиеся данные
-		ptr->end_ind = len - len_to_border;                                     // ставим индекс
 	}
 
-	Private_CircBuf_AddDataSizeValue(ptr, len);                                 // обновляем кол-во данных
+	Private_CircBuf_PushData(ptr, len);                                         // обновляем индекс и кол-во данных
+
+	Private_CircBuf_WmCheck(ptr, CIRC_BUF_WM_EVT_HI);                           // проверка порогов заполнения
 
 	return CIRC_BUF__OK;
 }
@@ -153,6 +297,9 @@ circ_buf_error_code_t CircBuf_AddData(circ_buf_t *ptr, uint8_t* data, uint16_t l
 // добавить данные в кольцевой буфер потокобезопасно
 circ_buf_error_code_t CircBuf_AddDataProtected(circ_buf_t *ptr, uint8_t* data, uint16_t len)
 {
+	if((ptr != NULL) && (ptr->mode & CIRC_BUF_MODE_SPSC))
+		return CircBuf_AddData(ptr, data, len);                                 // писатель единственный, защита не нужна
+
 	uint32_t s;
 	ENTER_CRITICAL(s);
 	circ_buf_error_code_t ret = CircBuf_AddData(ptr, data, len);
@@ -170,7 +317,7 @@ void CircBuf_SetStartInd(circ_buf_t *ptr, uint16_t index)
 		return;
 
 	// вычисляем ко-во удаляемых данных
-	pop_data = index - ptr->start_ind;
+	pop_data = index - (ptr->start_ind & ptr->ind_mask);
 
 	// если удаляемых данных есть
 	if(pop_data != 0)
@@ -180,12 +327,305 @@ void CircBuf_SetStartInd(circ_buf_t *ptr, uint16_t index)
 			pop_data += ptr->buf_len;
 
 		// обновляем индек и кол-во данных
-		ptr->start_ind = index;
-		Private_CircBuf_AddDataSizeValue(ptr, -pop_data);
+		Private_CircBuf_PopData(ptr, pop_data);
 	}
 }
 
 
+// прочитать данные из буфера (не более max_len), возвращает число прочитанных байт
+uint16_t CircBuf_ReadData(circ_buf_t *ptr, uint8_t *dst, uint16_t max_len)
+{
+	uint16_t len;
+
+	if((ptr == NULL) || (dst == NULL))
+		return 0;
+
+	if(ptr->mode & CIRC_BUF_MODE_OVERWRITE)
+		return Private_CircBuf_OvrReadData(ptr, dst, max_len);
+
+	len = CircBuf_GetDataLen(ptr);
+	if(len > max_len)
+		len = max_len;
+
+	if(len == 0)
+		return 0;
+
+	Private_CircBuf_CopyOut(ptr, dst, ptr->start_ind, len);                     // копируем данные
+
+	Private_CircBuf_PopData(ptr, len);                                          // обновляем индекс и кол-во данных
+
+	return len;
+}
+
+
+// удалить данные из буфера (не более len), возвращает число удалённых байт
+uint16_t CircBuf_Skip(circ_buf_t *ptr, uint16_t len)
+{
+	uint16_t data_len;
+
+	if(ptr == NULL)
+		return 0;
+
+	data_len = CircBuf_GetDataLen(ptr);
+	if(len > data_len)
+		len = data_len;
+
+	if(len != 0)
+		Private_CircBuf_PopData(ptr, len);
+
+	return len;
+}
+
+
+// прерывание DMA: принята половина буфера (режим CIRC_BUF_MODE_DMA)
+void CircBuf_DmaHalfCpltIrq(circ_buf_t *ptr)
+{
+	if(ptr == NULL)
+		return;
+
+	ptr->dma.evt_cnt++;
+
+	Private_CircBuf_WmCheck(ptr, CIRC_BUF_WM_EVT_HI | CIRC_BUF_WM_EVT_LO);      // проверка порогов заполнения
+
+	if(ptr->dma.evt_cbk != NULL)
+		ptr->dma.evt_cbk();
+}
+
+
+// прерывание DMA: принят весь буфер (режим CIRC_BUF_MODE_DMA)
+void CircBuf_DmaCpltIrq(circ_buf_t *ptr)
+{
+	if(ptr == NULL)
+		return;
+
+	ptr->dma.evt_cnt++;
+
+	Private_CircBuf_WmCheck(ptr, CIRC_BUF_WM_EVT_HI | CIRC_BUF_WM_EVT_LO);      // проверка порогов заполнения
+
+	if(ptr->dma.evt_cbk != NULL)
+		ptr->dma.evt_cbk();
+}
+
+
+// получить непрерывный участок данных для чтения без копирования (до границы буфера)
+uint8_t* CircBuf_GetReadSpan(circ_buf_t *ptr, uint16_t *len)
+{
+	uint16_t pos;
+	uint16_t data_len;
+
+	if((ptr == NULL) || (len == NULL))
+		return NULL;
+
+	data_len = CircBuf_GetDataLen(ptr);
+	pos = ptr->start_ind & ptr->ind_mask;                                       // позиция чтения в буфере
+
+	*len = ptr->buf_len - pos;                                                  // расстояние до границы буфера
+	if((*len > data_len) || (ptr->mode & CIRC_BUF_MODE_MIRROR))
+		*len = data_len;
+
+	return &ptr->buf_ptr[pos];
+}
+
+
+// получить непрерывный участок свободного места для записи без копирования (до границы буфера)
+uint8_t* CircBuf_GetWriteSpan(circ_buf_t *ptr, uint16_t *len)
+{
+	uint16_t pos;
+	uint16_t free_len;
+
+	if((ptr == NULL) || (len == NULL))
+		return NULL;
+
+	if(ptr->mode & CIRC_BUF_MODE_DMA)                                           // пишет только DMA
+	{
+		*len = 0;
+		return NULL;
+	}
+
+	free_len = CircBuf_GetFreeLen(ptr);
+	pos = ptr->end_ind & ptr->ind_mask;                                         // позиция записи в буфере
+
+	*len = ptr->buf_len - pos;                                                  // расстояние до границы буфера
+	if((*len > free_len) || (ptr->mode & CIRC_BUF_MODE_MIRROR))
+		*len = free_len;
+
+	return &ptr->buf_ptr[pos];
+}
+
+
+// зафиксировать len байт, записанных в участок CircBuf_GetWriteSpan
+circ_buf_error_code_t CircBuf_CommitWrite(circ_buf_t *ptr, uint16_t len)
+{
+	if(ptr == NULL)
+		return CIRC_BUF__NULL_POINTER;
+
+	if(ptr->mode & CIRC_BUF_MODE_DMA)
+		return CIRC_BUF__WRONG_ARG;
+
+	if(len > CircBuf_GetFreeLen(ptr))
+		return CIRC_BUF__OVF;
+
+	if(len != 0)
+	{
+		Private_CircBuf_PushData(ptr, len);                                     // обновляем индекс и кол-во данных
+		Private_CircBuf_WmCheck(ptr, CIRC_BUF_WM_EVT_HI);                       // проверка порогов заполнения
+	}
+
+	return CIRC_BUF__OK;
+}
+
+
+// заполнить массив участками данных для чтения без копирования
+uint8_t CircBuf_GetReadSegs(circ_buf_t *ptr, circ_buf_seg_t *seg, uint16_t *len)
+{
+	uint16_t data_len;
+
+	if((ptr == NULL) || (seg == NULL))
+		return 0;
+
+	data_len = CircBuf_GetDataLen(ptr);
+
+	if(len != NULL)
+		*len = data_len;
+
+	return Private_CircBuf_FillSegs(ptr, seg, ptr->start_ind & ptr->ind_mask, data_len);
+}
+
+
+// заполнить массив участками данных между индексами
+uint8_t CircBuf_GetSegsBetweenIndexes(circ_buf_t *ptr, circ_buf_seg_t *seg, uint16_t start_ind, uint16_t end_ind)
+{
+	if((ptr == NULL) || (seg == NULL))
+		return 0;
+
+	if((start_ind >= ptr->buf_len) || (end_ind >= ptr->buf_len))
+		return 0;
+
+	return Private_CircBuf_FillSegs(ptr, seg, start_ind, CircBuf_GetDataLenBetweenIndexes(ptr, start_ind, end_ind));
+}
+
+
+// удалить из буфера данные участков, полученных через CircBuf_GetReadSegs
+uint16_t CircBuf_ConsumeSegs(circ_buf_t *ptr, circ_buf_seg_t *seg, uint8_t seg_num)
+{
+	uint32_t len = 0;
+
+	if((ptr == NULL) || (seg == NULL))
+		return 0;
+
+	for(uint8_t i = 0; i < seg_num; i++)
+		len += seg[i].len;
+
+	if(len > 0xFFFF)
+		len = 0xFFFF;
+
+	return CircBuf_Skip(ptr, (uint16_t)len);
+}
+
+
+// настроить пороги заполнения
+circ_buf_error_code_t CircBuf_SetWatermarks(circ_buf_t *ptr, circ_buf_wm_init_t *init)
+{
+	uint32_t s;
+
+	if((ptr == NULL) || (init == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	// нижний порог меньше верхнего, верхний порог достижим
+	if((init->hi != 0) && ((init->lo >= init->hi) || (init->hi > Private_CircBuf_GetFreeLen(ptr, 0))))
+		return CIRC_BUF__WRONG_ARG;
+
+	ENTER_CRITICAL(s);
+	ptr->wm.hi      = init->hi;
+	ptr->wm.lo      = init->lo;
+	ptr->wm.hi_cbk  = init->hi_cbk;
+	ptr->wm.lo_cbk  = init->lo_cbk;
+	ptr->wm.defer   = init->defer;
+	ptr->wm.state   = 0;
+	ptr->wm.pending = 0;
+	LEAVE_CRITICAL(s);
+
+	Private_CircBuf_WmCheck(ptr, CIRC_BUF_WM_EVT_HI | CIRC_BUF_WM_EVT_LO);      // буфер мог быть уже заполнен
+
+	return CIRC_BUF__OK;
+}
+
+
+// обработать отложенные события порогов
+uint8_t CircBuf_WmProc(circ_buf_t *ptr)
+{
+	uint32_t pending;
+	uint8_t evt;
+	uint32_t s;
+
+	if(ptr == NULL)
+		return 0;
+
+	if(ptr->mode & CIRC_BUF_MODE_SPSC)
+	{
+		// события добавляют писатель и читатель без критической секции
+		do
+		{
+			pending = ptr->wm.pending;
+		}while(!ATOMIC_CAS32(&ptr->wm.pending, pending, 0));
+		evt = (uint8_t)pending;
+	}else
+	{
+		ENTER_CRITICAL(s);
+		evt = (uint8_t)ptr->wm.pending;
+		ptr->wm.pending = 0;
+		LEAVE_CRITICAL(s);
+	}
+
+	Private_CircBuf_WmCall(ptr, evt);
+
+	return evt;
+}
+
+
+// найти байт в данных буфера начиная со смещения from от начала данных
+circ_buf_error_code_t CircBuf_FindByte(circ_buf_t *ptr, uint8_t val, uint16_t from, uint16_t *offset)
+{
+	if((ptr == NULL) || (offset == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	return Private_CircBuf_FindByte(ptr, val, CircBuf_GetDataLen(ptr), from, offset);
+}
+
+
+// найти последовательность байт в данных буфера начиная со смещения from от начала данных
+circ_buf_error_code_t CircBuf_FindPattern(circ_buf_t *ptr, const uint8_t *pattern, uint16_t pattern_len, uint16_t from, uint16_t *offset)
+{
+	uint16_t len;
+	uint16_t ind;
+
+	if((ptr == NULL) || (pattern == NULL) || (offset == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	if(pattern_len == 0)
+		return CIRC_BUF__WRONG_ARG;
+
+	len = CircBuf_GetDataLen(ptr);
+
+	// ищем первый байт последовательности, затем сравниваем остальные
+	while(Private_CircBuf_FindByte(ptr, pattern[0], len, from, &ind) == CIRC_BUF__OK)
+	{
+		if(pattern_len > len - ind)                                             // последовательность не помещается в данные
+			break;
+
+		if(Private_CircBuf_Compare(ptr, ind, pattern, pattern_len) == 0)
+		{
+			*offset = ind;
+			return CIRC_BUF__OK;
+		}
+
+		from = ind + 1;
+	}
+
+	return CIRC_BUF__NOT_FOUND;
+}
+
+
 // увеличить индекс
 uint16_t CircBuf_AddIndValue(circ_buf_t *ptr, uint16_t val, uint16_t add)
 {
@@ -195,6 +635,9 @@ uint16_t CircBuf_AddIndValue(circ_buf_t *ptr, uint16_t val, uint16_t add)
 	if(ptr->buf_len == 0)
 		return 0;
 
+	if(ptr->mode & CIRC_BUF_MODE_POW2)
+		return (uint16_t)(val + add) & ptr->ind_mask;
+
 	val += add;
 	while(val >= ptr->buf_len)
 		val -= ptr->buf_len;
@@ -212,6 +655,9 @@ uint16_t CircBuf_IncIndValue(circ_buf_t *ptr, uint16_t val)
 	if(ptr->buf_len == 0)
 		return 0;
 
+	if(ptr->mode & CIRC_BUF_MODE_POW2)
+		return (uint16_t)(val + 1) & ptr->ind_mask;
+
 	val++;
 	while(val >= ptr->buf_len)
 		val -= ptr->buf_len;
@@ -306,3 +752,442 @@ static void Private_CircBuf_AddDataSizeValue(circ_buf_t *ptr, int16_t add)
 
   LEAVE_CRITICAL(s);               // окончание критической секции
 }
+
+
+// прочитать индекс, опубликованный другой стороной (acquire)
+static uint16_t Private_CircBuf_LoadInd(uint16_t *ind)
+{
+	uint16_t val = *(volatile uint16_t*)ind;
+
+	MEM_BARRIER();                   // последующие чтения данных не раньше чтения индекса
+
+	return val;
+}
+
+
+// опубликовать индекс для другой стороны (release)
+static void Private_CircBuf_StoreInd(uint16_t *ind, uint16_t val)
+{
+	MEM_BARRIER();                   // данные записаны до публикации индекса
+
+	*(volatile uint16_t*)ind = val;
+}
+
+
+// число данных, вычисленное по индексам (режим CIRC_BUF_MODE_SPSC)
+static uint16_t Private_CircBuf_GetIndDataLen(circ_buf_t *ptr)
+{
+	uint16_t start_ind = Private_CircBuf_LoadInd(&ptr->start_ind);
+	uint16_t end_ind   = Private_CircBuf_LoadInd(&ptr->end_ind);
+
+	if(ptr->mode & CIRC_BUF_MODE_POW2)
+		return end_ind - start_ind;                                             // разность свободно бегущих индексов
+
+	if(end_ind >= start_ind)
+		return end_ind - start_ind;
+
+	return ptr->buf_len - start_ind + end_ind;
+}
+
+
+// свободное место в буфере при заданном заполнении
+static uint16_t Private_CircBuf_GetFreeLen(circ_buf_t *ptr, uint16_t data_size)
+{
+	// в режиме POW2 полный и пустой буфер различаются по индексам, иначе один байт остаётся свободным
+	if(ptr->mode & CIRC_BUF_MODE_POW2)
+		return ptr->buf_len - data_size;
+
+	return ptr->buf_len - data_size - 1;
+}
+
+
+// сместить хранимый индекс на значение не больше длины буфера
+static uint16_t Private_CircBuf_AddInd(circ_buf_t *ptr, uint16_t ind, uint16_t add)
+{
+	if(ptr->mode & CIRC_BUF_MODE_POW2)
+		return ind + add;                                                       // индекс свободно бегущий
+
+	uint32_t val = (uint32_t)ind + add;
+	if(val >= ptr->buf_len)
+		val -= ptr->buf_len;
+
+	return (uint16_t)val;
+}
+
+
+// добавить записанные данные: сместить конечный индекс и обновить кол-во данных
+static void Private_CircBuf_PushData(circ_buf_t *ptr, uint16_t len)
+{
+	uint16_t end_ind = Private_CircBuf_AddInd(ptr, ptr->end_ind, len);          // смещаем индекс конца с закольцовкой
+
+	if(ptr->mode & CIRC_BUF_MODE_SPSC)
+	{
+		Private_CircBuf_StoreInd(&ptr->end_ind, end_ind);                       // публикуем индекс после записи данных
+		return;
+	}
+
+	ptr->end_ind = end_ind;
+	Private_CircBuf_AddDataSizeValue(ptr, len);                                 // обновляем кол-во данных
+}
+
+
+// удалить прочитанные данные: сместить стартовый индекс и обновить кол-во данных
+static void Private_CircBuf_PopData(circ_buf_t *ptr, uint16_t len)
+{
+	uint16_t index = Private_CircBuf_AddInd(ptr, ptr->start_ind, len);
+
+	// в режиме SPSC только публикуем индекс, писатель вычислит свободное место сам
+	if(ptr->mode & CIRC_BUF_MODE_SPSC)
+	{
+		Private_CircBuf_StoreInd(&ptr->start_ind, index);
+	}
+
+	// в режиме DMA счётчик ведёт только читатель
+	else if(ptr->mode & CIRC_BUF_MODE_DMA)
+	{
+		ptr->start_ind = index;
+		ptr->data_size -= len;
+	}
+
+	// в режиме вытеснения писатель мог сместить стартовый индекс, удаляем от текущего
+	else if(ptr->mode & CIRC_BUF_MODE_OVERWRITE)
+	{
+		uint32_t s;
+
+		ENTER_CRITICAL(s);
+		if(len > ptr->data_size)
+			len = ptr->data_size;
+		ptr->start_ind = Private_CircBuf_AddInd(ptr, ptr->start_ind, len);
+		ptr->data_size -= len;
+		LEAVE_CRITICAL(s);
+	}
+
+	else
+	{
+		ptr->start_ind = index;
+		Private_CircBuf_AddDataSizeValue(ptr, -(int32_t)len);
+	}
+
+	Private_CircBuf_WmCheck(ptr, CIRC_BUF_WM_EVT_LO);                           // проверка порогов заполнения
+}
+
+
+// разбить len байт начиная с позиции pos на участки до и после границы буфера
+static uint8_t Private_CircBuf_FillSegs(circ_buf_t *ptr, circ_buf_seg_t *seg, uint16_t pos, uint16_t len)
+{
+	uint16_t len_to_border = ptr->buf_len - pos;                                // расстояние до границы буфера
+
+	if(len == 0)
+		return 0;
+
+	seg[0].ptr = &ptr->buf_ptr[pos];
+
+	// если данные не пересекают границу или за границей отображена копия буфера
+	if((len <= len_to_border) || (ptr->mode & CIRC_BUF_MODE_MIRROR))
+	{
+		seg[0].len = len;
+		return 1;
+	}
+
+	seg[0].len = len_to_border;                                                 // участок до границы
+	seg[1].ptr = &ptr->buf_ptr[0];                                              // оставшиеся данные с начала буфера
+	seg[1].len = len - len_to_border;
+	return 2;
+}
+
+
+// скопировать len байт из буфера начиная с индекса
+static void Private_CircBuf_CopyOut(circ_buf_t *ptr, uint8_t *dst, uint16_t ind, uint16_t len)
+{
+	uint16_t pos = ind & ptr->ind_mask;                                         // позиция чтения в буфере
+	uint16_t len_to_border = ptr->buf_len - pos;                                // расстояние до границы буфера
+
+	// если данные не пересекают границу или за границей отображена копия буфера
+	if((len <= len_to_border) || (ptr->mode & CIRC_BUF_MODE_MIRROR))
+	{
+		memcpy(dst, &ptr->buf_ptr[pos], len);                                   // копируем данные
+	}else                                                                       // если данные пересекают границу
+	{
+		memcpy(dst, &ptr->buf_ptr[pos], len_to_border);                         // копируем до границы
+		memcpy(&dst[len_to_border], &ptr->buf_ptr[0], len - len_to_border);     // копируем оставшиеся данные
+	}
+}
+
+
+// вытеснить старые данные, чтобы освободить место под len байт (режим CIRC_BUF_MODE_OVERWRITE)
+// стартовый индекс смещается до записи новых данных, поэтому читатель узнает о вытеснении по ovr_bytes
+static void Private_CircBuf_DiscardOld(circ_buf_t *ptr, uint16_t len)
+{
+	uint32_t s;
+	uint16_t free_len;
+
+	ENTER_CRITICAL(s);
+
+	free_len = Private_CircBuf_GetFreeLen(ptr, ptr->data_size);
+	if(len > free_len)
+	{
+		len -= free_len;                                                        // сколько старых данных вытесняем
+		ptr->start_ind = Private_CircBuf_AddInd(ptr, ptr->start_ind, len);
+		ptr->data_size -= len;
+		ptr->ovr_bytes += len;
+	}
+
+	LEAVE_CRITICAL(s);
+}
+
+
+// прочитать данные с учётом вытеснения писателем (режим CIRC_BUF_MODE_OVERWRITE)
+// копирование идёт без запрета прерываний; если писатель за это время вытеснил часть скопированного,
+// эта часть отбрасывается, остальные данные не затронуты и остаются валидными
+static uint16_t Private_CircBuf_OvrReadData(circ_buf_t *ptr, uint8_t *dst, uint16_t max_len)
+{
+	uint32_t s;
+	uint16_t len;
+	uint16_t start_ind;
+	uint32_t ovr_bytes;
+	uint32_t lost;
+
+	do
+	{
+		// согласованный снимок состояния
+		ENTER_CRITICAL(s);
+		len = ptr->data_size;
+		start_ind = ptr->start_ind;
+		ovr_bytes = ptr->ovr_bytes;
+		LEAVE_CRITICAL(s);
+
+		if(len > max_len)
+			len = max_len;
+
+		if(len == 0)
+			return 0;
+
+		Private_CircBuf_CopyOut(ptr, dst, start_ind, len);                      // копируем данные
+
+		ENTER_CRITICAL(s);
+		lost = ptr->ovr_bytes - ovr_bytes;                                      // вытеснено во время копирования
+		if(lost < len)
+		{
+			len -= lost;
+			ptr->start_ind = Private_CircBuf_AddInd(ptr, ptr->start_ind, len);
+			ptr->data_size -= len;
+		}
+		LEAVE_CRITICAL(s);
+
+	}while(lost >= len);                                                        // всё скопированное вытеснено, повторяем
+
+	Private_CircBuf_WmCheck(ptr, CIRC_BUF_WM_EVT_LO);                           // проверка порогов заполнения
+
+	if(lost != 0)
+		memmove(dst, &dst[lost], len);
+
+	return len;
+}
+
+
+// проверить пересечение порогов заполнения и вызвать или отложить callback
+// заполнение и состояние порогов читаются в одной критической секции, чтобы писатель и читатель
+// не могли применить устаревшее заполнение и пропустить переход
+// в режиме CIRC_BUF_MODE_SPSC прерывания не запрещаются: заполнение берётся по снимку индексов,
+// писатель только взводит верхний порог (state 0 -> 1), читатель только сбрасывает его (1 -> 0),
+// поэтому state в каждый момент изменяет одна сторона, а отложенные события добавляются атомарно
+static void Private_CircBuf_WmCheck(circ_buf_t *ptr, uint8_t side)
+{
+	uint16_t level;
+	uint16_t pos;
+	uint32_t pending;
+	uint8_t evt = 0;
+	uint32_t s;
+
+	if(ptr->wm.hi == 0)
+		return;
+
+	if(ptr->mode & CIRC_BUF_MODE_SPSC)
+	{
+		level = Private_CircBuf_GetIndDataLen(ptr);
+
+		if((side & CIRC_BUF_WM_EVT_HI) && !ptr->wm.state && (level >= ptr->wm.hi))
+		{
+			evt = CIRC_BUF_WM_EVT_HI;
+			ptr->wm.state = 1;                                                  // дальше состоянием владеет читатель
+		}
+		else if((side & CIRC_BUF_WM_EVT_LO) && ptr->wm.state && (level <= ptr->wm.lo))
+		{
+			evt = CIRC_BUF_WM_EVT_LO;
+			ptr->wm.state = 0;                                                  // дальше состоянием владеет писатель
+		}
+
+		if(ptr->wm.defer && evt)
+		{
+			do
+			{
+				pending = ptr->wm.pending;
+			}while(!ATOMIC_CAS32(&ptr->wm.pending, pending, pending | evt));
+			evt = 0;
+		}
+
+		Private_CircBuf_WmCall(ptr, evt);
+		return;
+	}
+
+	ENTER_CRITICAL(s);
+
+	if(ptr->mode & CIRC_BUF_MODE_DMA)
+	{
+		// оценка по позиции DMA без изменения состояния, допустима и в прерывании DMA
+		pos = ptr->dma.pos_cbk();
+		if(pos >= ptr->buf_len)
+			pos = 0;
+		level = (pos >= ptr->start_ind) ? (pos - ptr->start_ind) : (ptr->buf_len - ptr->start_ind + pos);
+	}
+	else
+	{
+		level = ptr->data_size;
+	}
+
+	if(!ptr->wm.state && (level >= ptr->wm.hi))
+	{
+		ptr->wm.state = 1;
+		evt = CIRC_BUF_WM_EVT_HI;
+	}
+	else if(ptr->wm.state && (level <= ptr->wm.lo))
+	{
+		ptr->wm.state = 0;
+		evt = CIRC_BUF_WM_EVT_LO;
+	}
+
+	if(ptr->wm.defer)
+	{
+		ptr->wm.pending |= evt;
+		evt = 0;
+	}
+
+	LEAVE_CRITICAL(s);
+
+	Private_CircBuf_WmCall(ptr, evt);
+}
+
+
+// вызвать callback событий порогов
+// если отложены оба события, последним вызывается соответствующее текущему состоянию
+static void Private_CircBuf_WmCall(circ_buf_t *ptr, uint8_t evt)
+{
+	if(ptr->wm.state)
+	{
+		if((evt & CIRC_BUF_WM_EVT_LO) && (ptr->wm.lo_cbk != NULL))
+			ptr->wm.lo_cbk();
+		if((evt & CIRC_BUF_WM_EVT_HI) && (ptr->wm.hi_cbk != NULL))
+			ptr->wm.hi_cbk();
+	}else
+	{
+		if((evt & CIRC_BUF_WM_EVT_HI) && (ptr->wm.hi_cbk != NULL))
+			ptr->wm.hi_cbk();
+		if((evt & CIRC_BUF_WM_EVT_LO) && (ptr->wm.lo_cbk != NULL))
+			ptr->wm.lo_cbk();
+	}
+}
+
+
+// найти байт среди len байт данных начиная со смещения from
+// поиск идёт memchr по непрерывным участкам до и после границы буфера
+static circ_buf_error_code_t Private_CircBuf_FindByte(circ_buf_t *ptr, uint8_t val, uint16_t len, uint16_t from, uint16_t *offset)
+{
+	uint16_t pos;
+	uint16_t len_to_border;
+	uint8_t *res;
+
+	if(from >= len)
+		return CIRC_BUF__NOT_FOUND;
+
+	pos = ptr->start_ind & ptr->ind_mask;                                       // позиция начала данных в буфере
+	len_to_border = ptr->buf_len - pos;                                         // расстояние до границы буфера
+
+	// участок до границы буфера
+	if(from < len_to_border)
+	{
+		uint16_t part_len = (len < len_to_border) ? len : len_to_border;
+
+		res = memchr(&ptr->buf_ptr[pos + from], val, part_len - from);
+		if(res != NULL)
+		{
+			*offset = (uint16_t)(res - &ptr->buf_ptr[pos]);
+			return CIRC_BUF__OK;
+		}
+
+		from = len_to_border;
+	}
+
+	// участок после границы буфера
+	if(from < len)
+	{
+		res = memchr(&ptr->buf_ptr[from - len_to_border], val, len - from);
+		if(res != NULL)
+		{
+			*offset = (uint16_t)(res - ptr->buf_ptr) + len_to_border;
+			return CIRC_BUF__OK;
+		}
+	}
+
+	return CIRC_BUF__NOT_FOUND;
+}
+
+
+// сравнить данные по смещению от начала данных с последовательностью
+static int Private_CircBuf_Compare(circ_buf_t *ptr, uint16_t offset, const uint8_t *pattern, uint16_t pattern_len)
+{
+	uint16_t pos = Private_CircBuf_AddInd(ptr, ptr->start_ind, offset) & ptr->ind_mask;
+	uint16_t len_to_border = ptr->buf_len - pos;
+	int ret;
+
+	// если последовательность не пересекает границу
+	if(pattern_len <= len_to_border)
+		return memcmp(&ptr->buf_ptr[pos], pattern, pattern_len);
+
+	ret = memcmp(&ptr->buf_ptr[pos], pattern, len_to_border);
+	if(ret != 0)
+		return ret;
+
+	return memcmp(&ptr->buf_ptr[0], &pattern[len_to_border], pattern_len - len_to_border);
+}
+
+
+// синхронизация с позицией DMA (режим CIRC_BUF_MODE_DMA)
+// DMA не может обогнать читателя незаметно: каждый круг даёт два прерывания (половина и конец буфера),
+// поэтому прерываний больше, чем границ пройденных по позициям, означает, что DMA прошёл лишний круг
+static uint16_t Private_CircBuf_DmaSync(circ_buf_t *ptr)
+{
+	uint32_t evt_cnt = ptr->dma.evt_cnt;                                        // счётчик читаем до позиции
+	uint16_t pos = ptr->dma.pos_cbk();
+	uint16_t half = ptr->buf_len / 2;
+	uint32_t adv;
+
+	if(pos >= ptr->buf_len)                                                     // момент перезагрузки счётчика DMA
+		pos = 0;
+
+	// продвижение DMA с прошлой синхронизации
+	adv = (pos >= ptr->end_ind) ? (pos - ptr->end_ind) : (ptr->buf_len - ptr->end_ind + pos);
+
+	// границы половины и конца буфера, пройденные по позициям
+	ptr->dma.evt_exp += (ptr->end_ind + adv) / half - ptr->end_ind / half;
+
+	// проверка на переполнение: DMA догнал начало данных или прошёл лишний круг
+	if(((int32_t)(evt_cnt - ptr->dma.evt_exp) > 0) || ((ptr->data_size + adv) >= ptr->buf_len))
+	{
+		ptr->ovf_err_cnt++;
+		ptr->lost_bytes += ptr->buf_len;                                        // содержимое буфера отбрасывается
+
+		// каждый лишний круг даёт ровно два прерывания; округление вверх до чётного учитывает прерывание,
+		// границу которого DMA уже прошёл, но обработчик ещё не выполнен (иначе оно даст ложное переполнение)
+		ptr->dma.evt_exp += (evt_cnt - ptr->dma.evt_exp + 1) & ~1UL;
+		ptr->start_ind = pos;
+		ptr->end_ind = pos;
+		ptr->data_size = 0;
+
+		return 0;
+	}
+
+	ptr->end_ind = pos;
+	ptr->data_size += adv;
+
+	return ptr->data_size;
+}
@@ -37,65 +37,241 @@ typedef enum
 	CIRC_BUF__NULL_POINTER,                // нулевой указатель
 	CIRC_BUF__WRONG_ARG,                   // неверный аргумент
 	CIRC_BUF__OVF,                         // переполнение
+	CIRC_BUF__EMPTY,                       // нет данных
+	CIRC_BUF__NOT_FOUND,                   // не найдено
+	CIRC_BUF__ALLOC_ERR,                   // ошибка выделения памяти
 
 } circ_buf_error_code_t;
 
 
+// режимы работы буфера (флаги)
+#define CIRC_BUF_MODE_SPSC      0x01      // один писатель и один читатель: писатель владеет end_ind, читатель start_ind,
+                                          // data_size не используется, критические секции не нужны
+#define CIRC_BUF_MODE_POW2      0x02      // длина буфера - степень двойки (до 32768), индексы свободно бегущие,
+                                          // позиция в буфере вычисляется по маске, буфер заполняется полностью
+#define CIRC_BUF_MODE_DMA       0x04      // запись ведёт кольцевой канал DMA, end_ind вычисляется по позиции DMA
+                                          // при чтении, длина буфера чётная (несовместим с SPSC и POW2)
+#define CIRC_BUF_MODE_OVERWRITE 0x08      // при переполнении вытесняются самые старые данные (несовместим с SPSC и DMA),
+                                          // читать следует через CircBuf_ReadData / CircBuf_Skip
+#define CIRC_BUF_MODE_MIRROR    0x10      // за буфером отображена его копия, любой участок данных или свободного
+                                          // места непрерывен в памяти; устанавливается только CircBufMirror_Init
+
+#define CIRC_BUF_MODE_ALL       (CIRC_BUF_MODE_SPSC | CIRC_BUF_MODE_POW2 | CIRC_BUF_MODE_DMA | \
+                                 CIRC_BUF_MODE_OVERWRITE)   // флаги, допустимые в init->mode
+
+
+// описание callback функции получения позиции записи DMA (buf_len - счётчик оставшихся передач)
+typedef uint16_t (*circ_buf_dma_pos_cbk_t)();
+
+// описание callback функции события DMA (половина или весь буфер принят)
+typedef void (*circ_buf_dma_evt_cbk_t)();
+
+// описание callback функции пересечения порога заполнения
+typedef void (*circ_buf_wm_cbk_t)();
+
+
+#define CIRC_BUF_WM_EVT_HI      0x01      // заполнение достигло верхнего порога
+#define CIRC_BUF_WM_EVT_LO      0x02      // заполнение опустилось до нижнего порога
+
+
 // структура для инициализации
+// структуру следует обнулять целиком (circ_buf_init_t init = {0}), неизвестные флаги mode отклоняются CircBuf_Init
 typedef struct
 {
 	uint8_t* buf_ptr;                                                             // указатель на буфер приёма
 	uint16_t buf_len;                                                             // длина буфера
+	uint8_t  mode;                                                                // режим работы (флаги CIRC_BUF_MODE_...)
+
+	circ_buf_dma_pos_cbk_t dma_pos_cbk;                                           // позиция записи DMA (режим CIRC_BUF_MODE_DMA)
+	circ_buf_dma_evt_cbk_t dma_evt_cbk;                                           // событие DMA, может быть NULL (режим CIRC_BUF_MODE_DMA)
 
 } circ_buf_init_t;
 
 
+// переменные режима DMA
+typedef struct
+{
+	circ_buf_dma_pos_cbk_t pos_cbk;                                               // позиция записи DMA
+	circ_buf_dma_evt_cbk_t evt_cbk;                                               // событие DMA
+
+	volatile uint32_t evt_cnt;                                                    // счётчик прерываний половины и конца буфера
+	uint32_t evt_exp;                                                             // ожидаемое по позициям число прерываний
+
+} circ_buf_dma_t;
+
+
+// структура для настройки порогов заполнения
+typedef struct
+{
+	uint16_t hi;                                                                  // верхний порог, 0 - пороги отключены
+	uint16_t lo;                                                                  // нижний порог, меньше верхнего (гистерезис)
+
+	circ_buf_wm_cbk_t hi_cbk;                                                     // заполнение достигло hi, может быть NULL
+	circ_buf_wm_cbk_t lo_cbk;                                                     // заполнение опустилось до lo, может быть NULL
+
+	uint8_t defer;                                                                // 1 - callback вызываются из CircBuf_WmProc
+
+} circ_buf_wm_init_t;
+
+
+// переменные порогов заполнения
+typedef struct
+{
+	uint16_t hi;                                                                  // верхний порог, 0 - пороги отключены
+	uint16_t lo;                                                                  // нижний порог
+
+	circ_buf_wm_cbk_t hi_cbk;                                                     // заполнение достигло hi
+	circ_buf_wm_cbk_t lo_cbk;                                                     // заполнение опустилось до lo
+
+	uint8_t defer;                                                                // callback откладываются до CircBuf_WmProc
+	volatile uint8_t state;                                                       // 1 - верхний порог пройден, ожидается нижний
+	volatile uint32_t pending;                                                    // отложенные события (флаги CIRC_BUF_WM_EVT_...)
+
+} circ_buf_wm_t;
+
+
 // описание структуры кольцевого буфера
 typedef struct
 {
 	uint8_t* buf_ptr;                                                             // указатель на буфер приёма
 	uint16_t buf_len;                                                             // длина буфера
+	uint8_t  mode;                                                                // режим работы (флаги CIRC_BUF_MODE_...)
+	uint16_t ind_mask;                                                            // маска позиции в буфере (buf_len - 1 в режиме CIRC_BUF_MODE_POW2)
 
-	uint16_t start_ind;                                                           // начальный индекс данных
-	uint16_t end_ind;                                                             // конечный индекс данных
+	uint16_t start_ind;                                                           // начальный индекс данных (в режиме CIRC_BUF_MODE_POW2 свободно бегущий)
+	uint16_t end_ind;                                                             // конечный индекс данных (в режиме CIRC_BUF_MODE_POW2 свободно бегущий)
 	uint16_t data_size;                                                           // заполнение буфера в байтах
 
 	uint32_t ovf_err_cnt;                                                         // счётчик переполнения буфера
 	uint32_t lost_bytes;                                                          // потеряно байт
+	uint32_t ovr_bytes;                                                           // вытеснено старых байт (режим CIRC_BUF_MODE_OVERWRITE)
+
+	circ_buf_dma_t dma;                                                           // переменные режима DMA
+	circ_buf_wm_t  wm;                                                            // переменные порогов заполнения
 
 } circ_buf_t;
 
 
+#define CIRC_BUF_SEG_NUM        2         // максимальное число участков, на которые делятся данные буфера
+
+// участок памяти буфера для векторного ввода-вывода (цепочки дескрипторов DMA, writev)
+typedef struct
+{
+	uint8_t* ptr;                          // указатель на начало участка
+	uint16_t len;                          // длина участка
+
+} circ_buf_seg_t;
+
+
+// пакетная запись из прерывания: байты пишутся сразу в буфер и публикуются одним CircBuf_BatchCommit
+typedef struct
+{
+	circ_buf_t *cb;                        // кольцевой буфер
+	uint16_t pos;                          // позиция записи следующего байта
+	uint16_t len;                          // записано и не опубликовано байт
+	uint16_t free_len;                     // свободное место на начало пакета
+
+} circ_buf_batch_t;
+
+
 // инициализация
-void CircBuf_Init(circ_buf_t *ptr, circ_buf_init_t *init);
+// в режиме CIRC_BUF_MODE_POW2 при длине не степени двойки возвращает CIRC_BUF__WRONG_ARG,
+// CIRC_BUF_MODE_MIRROR в init->mode не допускается (буфер с копией создаёт CircBufMirror_Init)
+circ_buf_error_code_t CircBuf_Init(circ_buf_t *ptr, circ_buf_init_t *init);
 
 // получить размер буфера
 uint16_t CircBuf_GetBufLen(circ_buf_t *ptr);
 
 // получить число данных
+// в режиме CIRC_BUF_MODE_DMA синхронизирует конечный индекс с позицией DMA и проверяет переполнение
 uint16_t CircBuf_GetDataLen(circ_buf_t *ptr);
 
 // получить стартовый индекс
 uint16_t CircBuf_GetStartIndex(circ_buf_t *ptr);
 
+// получить свободное место в буфере
+uint16_t CircBuf_GetFreeLen(circ_buf_t *ptr);
+
 // получить указатель на буфер
 uint8_t* CircBuf_GetBufPtr(circ_buf_t *ptr);
 
-// получить указатель на буфер
+// получить указатель на длину данных
+// в режиме CIRC_BUF_MODE_SPSC счётчик не ведётся, используйте CircBuf_GetDataLen
 uint16_t* CircBuf_GetDataLenPtr(circ_buf_t *ptr);
 
 // получить указатель на стартовый индекс
+// в режиме CIRC_BUF_MODE_POW2 индекс свободно бегущий, позиция в буфере: (*ptr & ind_mask)
 uint16_t* CircBuf_GetStartIndexPtr(circ_buf_t *ptr);
 
 // добавить данные в кольцевой буфер
 circ_buf_error_code_t CircBuf_AddData(circ_buf_t *ptr, uint8_t* data, uint16_t len);
 
 // добавить данные в кольцевой буфер потокобезопасно
+// в режиме CIRC_BUF_MODE_SPSC прерывания не запрещаются
 circ_buf_error_code_t CircBuf_AddDataProtected(circ_buf_t *ptr, uint8_t* data, uint16_t len);
 
 // установить стартовый индекс (удаляет данные из буфера путем переноса стартового индекса)
+// индекс задаётся позицией в буфере, совпадение с текущей позицией ничего не удаляет
 void CircBuf_SetStartInd(circ_buf_t *ptr, uint16_t index);
 
+// прерывание DMA: принята половина буфера (режим CIRC_BUF_MODE_DMA)
+void CircBuf_DmaHalfCpltIrq(circ_buf_t *ptr);
+
+// прерывание DMA: принят весь буфер (режим CIRC_BUF_MODE_DMA)
+void CircBuf_DmaCpltIrq(circ_buf_t *ptr);
+
+// прочитать данные из буфера (не более max_len), возвращает число прочитанных байт
+// данные копируются не более чем двумя memcpy, состояние обновляется один раз
+uint16_t CircBuf_ReadData(circ_buf_t *ptr, uint8_t *dst, uint16_t max_len);
+
+// удалить данные из буфера (не более len), возвращает число удалённых байт
+uint16_t CircBuf_Skip(circ_buf_t *ptr, uint16_t len);
+
+// получить непрерывный участок данных для чтения без копирования (до границы буфера)
+// в режиме CIRC_BUF_MODE_MIRROR участок содержит все данные
+// после обработки данные удаляются через CircBuf_Skip
+uint8_t* CircBuf_GetReadSpan(circ_buf_t *ptr, uint16_t *len);
+
+// получить непрерывный участок свободного места для записи без копирования (до границы буфера)
+// в режиме CIRC_BUF_MODE_MIRROR участок содержит всё свободное место
+uint8_t* CircBuf_GetWriteSpan(circ_buf_t *ptr, uint16_t *len);
+
+// зафиксировать len байт, записанных в участок CircBuf_GetWriteSpan
+circ_buf_error_code_t CircBuf_CommitWrite(circ_buf_t *ptr, uint16_t len);
+
+// заполнить массив seg[CIRC_BUF_SEG_NUM] участками данных для чтения без копирования
+// возвращает число заполненных участков (0..2), len - общая длина данных (может быть NULL)
+uint8_t CircBuf_GetReadSegs(circ_buf_t *ptr, circ_buf_seg_t *seg, uint16_t *len);
+
+// заполнить массив seg[CIRC_BUF_SEG_NUM] участками данных между индексами (как CircBuf_DataCopyBetweenIndexes)
+// возвращает число заполненных участков (0..2)
+uint8_t CircBuf_GetSegsBetweenIndexes(circ_buf_t *ptr, circ_buf_seg_t *seg, uint16_t start_ind, uint16_t end_ind);
+
+// удалить из буфера данные seg_num участков, полученных через CircBuf_GetReadSegs
+// длины участков можно уменьшить, если передана только часть данных; возвращает число удалённых байт
+uint16_t CircBuf_ConsumeSegs(circ_buf_t *ptr, circ_buf_seg_t *seg, uint8_t seg_num);
+
+// настроить пороги заполнения
+// событие HI возникает, когда заполнение достигает hi, событие LO - когда после этого опускается до lo;
+// проверка выполняется при записи и удалении данных, в режиме DMA - также в прерываниях DMA
+// без defer callback вызываются в контексте записи или чтения (в CircBuf_AddDataProtected - при запрещённых прерываниях)
+// вне режима CIRC_BUF_MODE_SPSC проверка выполняется в критической секции (ENTER_CRITICAL) при каждой записи
+// и удалении данных; в режиме CIRC_BUF_MODE_SPSC прерывания не запрещаются: HI проверяет писатель, LO - читатель,
+// поэтому CircBuf_SetWatermarks вызывается до начала обмена или со стороны писателя
+circ_buf_error_code_t CircBuf_SetWatermarks(circ_buf_t *ptr, circ_buf_wm_init_t *init);
+
+// обработать отложенные события порогов (режим defer), вызывается из задачи
+// возвращает обработанные события (флаги CIRC_BUF_WM_EVT_...)
+uint8_t CircBuf_WmProc(circ_buf_t *ptr);
+
+// найти байт в данных буфера начиная со смещения from от начала данных
+// offset - смещение найденного байта от начала данных
+circ_buf_error_code_t CircBuf_FindByte(circ_buf_t *ptr, uint8_t val, uint16_t from, uint16_t *offset);
+
+// найти последовательность байт в данных буфера начиная со смещения from от начала данных
+// offset - смещение начала найденной последовательности от начала данных
+circ_buf_error_code_t CircBuf_FindPattern(circ_buf_t *ptr, const uint8_t *pattern, uint16_t pattern_len, uint16_t from, uint16_t *offset);
+
 // увеличить индекс
 uint16_t CircBuf_AddIndValue(circ_buf_t *ptr, uint16_t val, uint16_t add);
 
@@ -113,4 +289,262 @@ uint16_t CircBuf_DataSetBetweenIndexes(circ_buf_t *ptr, uint8_t val, uint16_t st
 
 
 
+// получить один байт из буфера (для побайтного разбора), без проверки указателей
+SFINLINE circ_buf_error_code_t CircBuf_GetByte(circ_buf_t *ptr, uint8_t *byte)
+{
+	uint16_t ind;
+	uint32_t s;
+
+	// в режимах SPSC и DMA число данных вычисляется по индексам, в режиме вытеснения нужна проверка,
+	// при включённых порогах нужна проверка заполнения
+	if((ptr->mode & (CIRC_BUF_MODE_SPSC | CIRC_BUF_MODE_DMA | CIRC_BUF_MODE_OVERWRITE)) || (ptr->wm.hi != 0))
+		return (CircBuf_ReadData(ptr, byte, 1) != 0) ? CIRC_BUF__OK : CIRC_BUF__EMPTY;
+
+	if(ptr->data_size == 0)
+		return CIRC_BUF__EMPTY;
+
+	ind = ptr->start_ind;
+	*byte = ptr->buf_ptr[ind & ptr->ind_mask];
+
+	ind++;
+	if((ind >= ptr->buf_len) && !(ptr->mode & CIRC_BUF_MODE_POW2))              // в режиме POW2 индекс свободно бегущий
+		ind = 0;
+	ptr->start_ind = ind;
+
+	ENTER_CRITICAL(s);
+	ptr->data_size--;
+	LEAVE_CRITICAL(s);
+
+	return CIRC_BUF__OK;
+}
+
+
+// записать n байт (короткие данные) в буфер, без проверки указателей
+// в режимах SPSC, DMA, вытеснения и при включённых порогах выполняется CircBuf_AddData
+SFINLINE circ_buf_error_code_t CircBuf_PutSmall(circ_buf_t *ptr, const uint8_t *src, uint8_t n)
+{
+	uint16_t ind;
+	uint32_t s;
+
+	if((ptr->mode & (CIRC_BUF_MODE_SPSC | CIRC_BUF_MODE_DMA | CIRC_BUF_MODE_OVERWRITE)) || (ptr->wm.hi != 0))
+		return CircBuf_AddData(ptr, (uint8_t*)src, n);
+
+	// проверка на переполение буфера, в режиме POW2 доступна вся длина
+	if(n > ptr->buf_len - ((ptr->mode & CIRC_BUF_MODE_POW2) ? 0 : 1) - ptr->data_size)
+	{
+		ptr->ovf_err_cnt++;
+		ptr->lost_bytes += n;
+
+		return CIRC_BUF__OVF;
+	}
+
+	ind = ptr->end_ind;
+	for(uint8_t i = 0; i < n; i++)
+	{
+		ptr->buf_ptr[ind & ptr->ind_mask] = src[i];
+
+		ind++;
+		if((ind >= ptr->buf_len) && !(ptr->mode & CIRC_BUF_MODE_POW2))          // в режиме POW2 индекс свободно бегущий
+			ind = 0;
+	}
+	ptr->end_ind = ind;
+
+	ENTER_CRITICAL(s);
+	ptr->data_size += n;
+	LEAVE_CRITICAL(s);
+
+	return CIRC_BUF__OK;
+}
+
+
+// прочитать n байт (короткие данные) из буфера, без проверки указателей
+// если данных меньше n, ничего не читается и возвращается CIRC_BUF__EMPTY
+SFINLINE circ_buf_error_code_t CircBuf_GetSmall(circ_buf_t *ptr, uint8_t *dst, uint8_t n)
+{
+	uint16_t ind;
+	uint32_t s;
+
+	if((ptr->mode & (CIRC_BUF_MODE_SPSC | CIRC_BUF_MODE_DMA | CIRC_BUF_MODE_OVERWRITE)) || (ptr->wm.hi != 0))
+	{
+		if(CircBuf_GetDataLen(ptr) < n)
+			return CIRC_BUF__EMPTY;
+
+		return (CircBuf_ReadData(ptr, dst, n) == n) ? CIRC_BUF__OK : CIRC_BUF__EMPTY;
+	}
+
+	if(ptr->data_size < n)
+		return CIRC_BUF__EMPTY;
+
+	ind = ptr->start_ind;
+	for(uint8_t i = 0; i < n; i++)
+	{
+		dst[i] = ptr->buf_ptr[ind & ptr->ind_mask];
+
+		ind++;
+		if((ind >= ptr->buf_len) && !(ptr->mode & CIRC_BUF_MODE_POW2))          // в режиме POW2 индекс свободно бегущий
+			ind = 0;
+	}
+	ptr->start_ind = ind;
+
+	ENTER_CRITICAL(s);
+	ptr->data_size -= n;
+	LEAVE_CRITICAL(s);
+
+	return CIRC_BUF__OK;
+}
+
+
+// записать один байт в буфер (для побайтного приёма в прерывании), без проверки указателей
+// прямой путь без цикла: одна проверка режима, одна проверка места, запись и сдвиг индекса
+SFINLINE circ_buf_error_code_t CircBuf_PutByte(circ_buf_t *ptr, uint8_t byte)
+{
+	uint16_t ind;
+	uint32_t s;
+
+	if((ptr->mode & (CIRC_BUF_MODE_SPSC | CIRC_BUF_MODE_DMA | CIRC_BUF_MODE_OVERWRITE)) || (ptr->wm.hi != 0))
+		return CircBuf_AddData(ptr, &byte, 1);
+
+	if(ptr->data_size >= ptr->buf_len - ((ptr->mode & CIRC_BUF_MODE_POW2) ? 0 : 1))
+	{
+		ptr->ovf_err_cnt++;
+		ptr->lost_bytes++;
+
+		return CIRC_BUF__OVF;
+	}
+
+	ind = ptr->end_ind;
+	ptr->buf_ptr[ind & ptr->ind_mask] = byte;
+
+	ind++;
+	if((ind >= ptr->buf_len) && !(ptr->mode & CIRC_BUF_MODE_POW2))              // в режиме POW2 индекс свободно бегущий
+		ind = 0;
+	ptr->end_ind = ind;
+
+	ENTER_CRITICAL(s);
+	ptr->data_size++;
+	LEAVE_CRITICAL(s);
+
+	return CIRC_BUF__OK;
+}
+
+
+// записать 16-битное слово (порядок байт как в памяти), без проверки указателей
+SFINLINE circ_buf_error_code_t CircBuf_PutWord16(circ_buf_t *ptr, uint16_t val)
+{
+	return CircBuf_PutSmall(ptr, (const uint8_t*)&val, 2);
+}
+
+
+// записать 32-битное слово (порядок байт как в памяти), без проверки указателей
+SFINLINE circ_buf_error_code_t CircBuf_PutWord32(circ_buf_t *ptr, uint32_t val)
+{
+	return CircBuf_PutSmall(ptr, (const uint8_t*)&val, 4);
+}
+
+
+// прочитать 16-битное слово, без проверки указателей
+SFINLINE circ_buf_error_code_t CircBuf_GetWord16(circ_buf_t *ptr, uint16_t *val)
+{
+	return CircBuf_GetSmall(ptr, (uint8_t*)val, 2);
+}
+
+
+// прочитать 32-битное слово, без проверки указателей
+SFINLINE circ_buf_error_code_t CircBuf_GetWord32(circ_buf_t *ptr, uint32_t *val)
+{
+	return CircBuf_GetSmall(ptr, (uint8_t*)val, 4);
+}
+
+
+// начать пакетную запись, без проверки указателей
+// до CircBuf_BatchCommit другие писатели в буфер писать не должны
+// в режимах DMA и вытеснения места под пакет нет, каждый CircBuf_BatchPut возвращает CIRC_BUF__OVF
+SFINLINE void CircBuf_BatchBegin(circ_buf_batch_t *b, circ_buf_t *ptr)
+{
+	b->cb       = ptr;
+	b->pos      = ptr->end_ind & ptr->ind_mask;
+	b->len      = 0;
+
+	if(ptr->mode & (CIRC_BUF_MODE_DMA | CIRC_BUF_MODE_OVERWRITE))                 // памятью владеет DMA или вытеснение
+		b->free_len = 0;
+	else
+		b->free_len = CircBuf_GetFreeLen(ptr);
+}
+
+
+// записать байт в пакет без публикации, без проверки указателей
+SFINLINE circ_buf_error_code_t CircBuf_BatchPut(circ_buf_batch_t *b, uint8_t byte)
+{
+	if(b->len >= b->free_len)
+	{
+		b->cb->ovf_err_cnt++;
+		b->cb->lost_bytes++;
+
+		return CIRC_BUF__OVF;
+	}
+
+	b->cb->buf_ptr[b->pos] = byte;
+
+	b->pos++;
+	if(b->pos >= b->cb->buf_len)
+		b->pos = 0;
+
+	b->len++;
+
+	return CIRC_BUF__OK;
+}
+
+
+// опубликовать записанные в пакет байты одной фиксацией, после неё пакет можно продолжать
+SFINLINE circ_buf_error_code_t CircBuf_BatchCommit(circ_buf_batch_t *b)
+{
+	circ_buf_error_code_t ret;
+
+	if(b->len == 0)
+		return CIRC_BUF__OK;
+
+	ret = CircBuf_CommitWrite(b->cb, b->len);
+
+	b->free_len -= b->len;
+	b->len = 0;
+
+	return ret;
+}
+
+
+// индексы режима CIRC_BUF_MODE_POW2 свободно бегущие (как start_ind / end_ind), маска применяется
+// только при обращении к массиву (CircBuf_Pow2Pos), поэтому расстояние buf_len (полный буфер) отличимо от 0
+
+// увеличить свободно бегущий индекс (только режим CIRC_BUF_MODE_POW2)
+SFINLINE uint16_t CircBuf_Pow2IncInd(circ_buf_t *ptr, uint16_t val)
+{
+	(void)ptr;
+	return (uint16_t)(val + 1);
+}
+
+
+// увеличить свободно бегущий индекс на значение (только режим CIRC_BUF_MODE_POW2)
+SFINLINE uint16_t CircBuf_Pow2AddInd(circ_buf_t *ptr, uint16_t val, uint16_t add)
+{
+	(void)ptr;
+	return (uint16_t)(val + add);
+}
+
+
+// позиция в массиве буфера по свободно бегущему индексу (только режим CIRC_BUF_MODE_POW2)
+SFINLINE uint16_t CircBuf_Pow2Pos(circ_buf_t *ptr, uint16_t ind)
+{
+	return ind & ptr->ind_mask;
+}
+
+
+// получить длинну данных между свободно бегущими индексами, 0..buf_len (только режим CIRC_BUF_MODE_POW2)
+SFINLINE uint16_t CircBuf_Pow2GetDistance(circ_buf_t *ptr, uint16_t start_ind, uint16_t end_ind)
+{
+	(void)ptr;
+	return (uint16_t)(end_ind - start_ind);
+}
+
+
+
 #endif /* APPLICATION_SUPPORTLIBS_CIRCBUF_H_ */
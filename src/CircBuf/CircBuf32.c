@@ -0,0 +1,374 @@
+/**************************************************************************//**
+ * @file      CircBuf32.c
+ * @brief     Circular buffer for data with 32-bit indexes. Source file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "CircBuf32.h"
+
+
+// безопасная работа с переменной data_size
+static void Private_CircBuf32_AddDataSizeValue(circ_buf32_t *ptr, int32_t add);
+
+// сместить индекс на значение не больше длины буфера
+static uint32_t Private_CircBuf32_AddInd(circ_buf32_t *ptr, uint32_t ind, uint32_t add);
+
+
+// инициализация
+circ_buf_error_code_t CircBuf32_Init(circ_buf32_t *ptr, circ_buf32_init_t *init)
+{
+	if((ptr == NULL) || (init == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	ptr->buf_ptr = init->buf_ptr;
+	ptr->buf_len = init->buf_len;
+
+	ptr->start_ind = 0;
+	ptr->end_ind = 0;
+	ptr->data_size = 0;
+
+	ptr->ovf_err_cnt = 0;
+	ptr->lost_bytes = 0;
+
+	return CIRC_BUF__OK;
+}
+
+
+// получить размер буфера
+uint32_t CircBuf32_GetBufLen(circ_buf32_t *ptr)
+{
+	if(ptr == NULL)
+		return 0;
+
+	return ptr->buf_len;
+}
+
+
+// получить число данных
+uint32_t CircBuf32_GetDataLen(circ_buf32_t *ptr)
+{
+	if(ptr == NULL)
+		return 0;
+
+	return ptr->data_size;
+}
+
+
+// получить стартовый индекс
+uint32_t CircBuf32_GetStartIndex(circ_buf32_t *ptr)
+{
+	if(ptr == NULL)
+		return 0;
+
+	return ptr->start_ind;
+}
+
+
+// получить указатель на буфер
+uint8_t* CircBuf32_GetBufPtr(circ_buf32_t *ptr)
+{
+	if(ptr == NULL)
+		return NULL;
+
+	return ptr->buf_ptr;
+}
+
+
+// получить указатель на длину данных
+uint32_t* CircBuf32_GetDataLenPtr(circ_buf32_t *ptr)
+{
+	if(ptr == NULL)
+		return NULL;
+
+	return &ptr->data_size;
+}
+
+
+// получить указатель на стартовый индекс
+uint32_t* CircBuf32_GetStartIndexPtr(circ_buf32_t *ptr)
+{
+	if(ptr == NULL)
+		return NULL;
+
+	return &ptr->start_ind;
+}
+
+
+// добавить данные в кольцевой буфер
+circ_buf_error_code_t CircBuf32_AddData(circ_buf32_t *ptr, uint8_t* data, uint32_t len)
+{
+	uint32_t len_to_border;
+
+	if((ptr == NULL) || (data == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	if(len == 0)
+		return CIRC_BUF__WRONG_ARG;
+
+	// проверка на переполение буфера
+	if(len >= (ptr->buf_len - ptr->data_size))
+	{
+		ptr->ovf_err_cnt++;
+		ptr->lost_bytes += len;
+
+		return CIRC_BUF__OVF;
+	}
+
+	len_to_border = ptr->buf_len - ptr->end_ind;                                // расстояние до границы буфера
+
+	// если данные не пересекают границу
+	if(len <= len_to_border)
+	{
+		memcpy(&ptr->buf_ptr[ptr->end_ind], data, len);                         // копируем данные
+	}else                                                                       // если данные пересекают границу
+	{
+		memcpy(&ptr->buf_ptr[ptr->end_ind], data, len_to_border);               // копируем до границы
+		memcpy(&ptr->buf_ptr[0], &data[len_to_border], len - len_to_border);    // копируем оставшиеся данные
+	}
+
+	ptr->end_ind = Private_CircBuf32_AddInd(ptr, ptr->end_ind, len);            // смещаем индекс конца с закольцовкой
+	Private_CircBuf32_AddDataSizeValue(ptr, len);                               // обновляем кол-во данных
+
+	return CIRC_BUF__OK;
+}
+
+
+// добавить данные в кольцевой буфер потокобезопасно
+circ_buf_error_code_t CircBuf32_AddDataProtected(circ_buf32_t *ptr, uint8_t* data, uint32_t len)
+{
+	uint32_t s;
+	ENTER_CRITICAL(s);
+	circ_buf_error_code_t ret = CircBuf32_AddData(ptr, data, len);
+	LEAVE_CRITICAL(s);
+	return ret;
+}
+
+
+// установить стартовый индекс (удаляет данные из буфера путем переноса стартового индекса)
+void CircBuf32_SetStartInd(circ_buf32_t *ptr, uint32_t index)
+{
+	uint32_t pop_data;
+
+	if(ptr == NULL)
+		return;
+
+	if(index >= ptr->buf_len)
+		return;
+
+	// вычисляем ко-во удаляемых данных с учётом перехода границы
+	if(index >= ptr->start_ind)
+		pop_data = index - ptr->start_ind;
+	else
+		pop_data = ptr->buf_len - ptr->start_ind + index;
+
+	// если удаляемых данных есть, обновляем индек и кол-во данных
+	if(pop_data != 0)
+	{
+		ptr->start_ind = index;
+		Private_CircBuf32_AddDataSizeValue(ptr, -(int32_t)pop_data);
+	}
+}
+
+
+// прочитать данные из буфера (не более max_len), возвращает число прочитанных байт
+uint32_t CircBuf32_ReadData(circ_buf32_t *ptr, uint8_t *dst, uint32_t max_len)
+{
+	uint32_t len;
+	uint32_t len_to_border;
+
+	if((ptr == NULL) || (dst == NULL))
+		return 0;
+
+	len = ptr->data_size;
+	if(len > max_len)
+		len = max_len;
+
+	if(len == 0)
+		return 0;
+
+	len_to_border = ptr->buf_len - ptr->start_ind;                              // расстояние до границы буфера
+
+	// если данные не пересекают границу
+	if(len <= len_to_border)
+	{
+		memcpy(dst, &ptr->buf_ptr[ptr->start_ind], len);                        // копируем данные
+	}else                                                                       // если данные пересекают границу
+	{
+		memcpy(dst, &ptr->buf_ptr[ptr->start_ind], len_to_border);              // копируем до границы
+		memcpy(&dst[len_to_border], &ptr->buf_ptr[0], len - len_to_border);     // копируем оставшиеся данные
+	}
+
+	ptr->start_ind = Private_CircBuf32_AddInd(ptr, ptr->start_ind, len);        // обновляем индекс и кол-во данных
+	Private_CircBuf32_AddDataSizeValue(ptr, -(int32_t)len);
+
+	return len;
+}
+
+
+// удалить данные из буфера (не более len), возвращает число удалённых байт
+uint32_t CircBuf32_Skip(circ_buf32_t *ptr, uint32_t len)
+{
+	if(ptr == NULL)
+		return 0;
+
+	if(len > ptr->data_size)
+		len = ptr->data_size;
+
+	if(len != 0)
+	{
+		ptr->start_ind = Private_CircBuf32_AddInd(ptr, ptr->start_ind, len);
+		Private_CircBuf32_AddDataSizeValue(ptr, -(int32_t)len);
+	}
+
+	return len;
+}
+
+
+// увеличить индекс
+uint32_t CircBuf32_AddIndValue(circ_buf32_t *ptr, uint32_t val, uint32_t add)
+{
+	if(ptr == NULL)
+		return 0;
+
+	if(ptr->buf_len == 0)
+		return 0;
+
+	// обычно аргументы уже в пределах буфера: перенос сравнением и вычитанием без деления,
+	// деление 32 бит только для значений вне буфера
+	if(val >= ptr->buf_len)
+		val %= ptr->buf_len;
+	if(add >= ptr->buf_len)
+		add %= ptr->buf_len;
+
+	return Private_CircBuf32_AddInd(ptr, val, add);
+}
+
+
+// увеличить индекс
+uint32_t CircBuf32_IncIndValue(circ_buf32_t *ptr, uint32_t val)
+{
+	if(ptr == NULL)
+		return 0;
+
+	if(ptr->buf_len == 0)
+		return 0;
+
+	val++;
+	if(val >= ptr->buf_len)
+		val = 0;
+
+	return val;
+}
+
+
+// получить длинну данных мжду заданными индексами
+uint32_t CircBuf32_GetDataLenBetweenIndexes(circ_buf32_t *ptr, uint32_t start_ind, uint32_t end_ind)
+{
+	if(ptr == NULL)
+		return 0;
+
+	if((start_ind >= ptr->buf_len) || (end_ind >= ptr->buf_len))
+		return 0;
+
+	if(end_ind >= start_ind)
+		return end_ind - start_ind;
+
+	return ptr->buf_len - start_ind + end_ind;
+}
+
+
+// скопировать данные между индексами
+uint32_t CircBuf32_DataCopyBetweenIndexes(circ_buf32_t *ptr, uint8_t *dst, uint32_t start_ind, uint32_t end_ind)
+{
+	if((ptr == NULL) || (dst == NULL))
+		return 0;
+
+	if((start_ind >= ptr->buf_len) || (end_ind >= ptr->buf_len))
+		return 0;
+
+	uint32_t part_len = 0;
+	if(end_ind < start_ind)
+	{
+		part_len = ptr->buf_len - start_ind;
+		memcpy(dst, &ptr->buf_ptr[start_ind], part_len);
+		memcpy(&dst[part_len], ptr->buf_ptr, end_ind);
+
+		part_len += end_ind;
+	}
+	else{
+		part_len = end_ind - start_ind;
+		memcpy(dst, &ptr->buf_ptr[start_ind], part_len);
+	}
+
+	return part_len;
+}
+
+
+// Установить данные между индексами
+uint32_t CircBuf32_DataSetBetweenIndexes(circ_buf32_t *ptr, uint8_t val, uint32_t start_ind, uint32_t end_ind)
+{
+	if(ptr == NULL)
+		return 0;
+
+	if((start_ind >= ptr->buf_len) || (end_ind >= ptr->buf_len))
+		return 0;
+
+	uint32_t part_len = 0;
+	if(end_ind < start_ind)
+	{
+		part_len = ptr->buf_len - start_ind;
+		memset(&ptr->buf_ptr[start_ind], val, part_len);
+		memset(ptr->buf_ptr, val, end_ind);
+
+		part_len += end_ind;
+	}
+	else{
+		part_len = end_ind - start_ind;
+		memset(&ptr->buf_ptr[start_ind], val, part_len);
+	}
+
+	return part_len;
+}
+
+
+
+
+// безопасная работа с переменной data_size
+static void Private_CircBuf32_AddDataSizeValue(circ_buf32_t *ptr, int32_t add)
+{
+	uint32_t s;
+
+	ENTER_CRITICAL(s);               // начало критической секции
+
+	ptr->data_size += add;           // инкремент на заданное значени
+
+	LEAVE_CRITICAL(s);               // окончание критической секции
+}
+
+
+// сместить индекс на значение не больше длины буфера
+static uint32_t Private_CircBuf32_AddInd(circ_buf32_t *ptr, uint32_t ind, uint32_t add)
+{
+	// разность вместо суммы исключает переполнение при длине буфера около 4 ГБ
+	if(add >= ptr->buf_len - ind)
+		return add - (ptr->buf_len - ind);
+
+	return ind + add;
+}
@@ -0,0 +1,109 @@
+/**************************************************************************//**
+ * @file      CircBuf32.h
+ * @brief     Circular buffer for data with 32-bit indexes. Header file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef APPLICATION_SUPPORTLIBS_CIRCBUF32_H_
+#define APPLICATION_SUPPORTLIBS_CIRCBUF32_H_
+
+
+#include "CircBuf.h"                    // коды ошибок
+
+
+
+// структура для инициализации
+typedef struct
+{
+	uint8_t* buf_ptr;                                                             // указатель на буфер приёма
+	uint32_t buf_len;                                                             // длина буфера
+
+} circ_buf32_init_t;
+
+
+// описание структуры кольцевого буфера с 32-битными индексами (буферы больше 64 КБ)
+typedef struct
+{
+	uint8_t* buf_ptr;                                                             // указатель на буфер приёма
+	uint32_t buf_len;                                                             // длина буфера
+
+	uint32_t start_ind;                                                           // начальный индекс данных
+	uint32_t end_ind;                                                             // конечный индекс данных
+	uint32_t data_size;                                                           // заполнение буфера в байтах
+
+	uint32_t ovf_err_cnt;                                                         // счётчик переполнения буфера
+	uint32_t lost_bytes;                                                          // потеряно байт
+
+} circ_buf32_t;
+
+
+// инициализация
+circ_buf_error_code_t CircBuf32_Init(circ_buf32_t *ptr, circ_buf32_init_t *init);
+
+// получить размер буфера
+uint32_t CircBuf32_GetBufLen(circ_buf32_t *ptr);
+
+// получить число данных
+uint32_t CircBuf32_GetDataLen(circ_buf32_t *ptr);
+
+// получить стартовый индекс
+uint32_t CircBuf32_GetStartIndex(circ_buf32_t *ptr);
+
+// получить указатель на буфер
+uint8_t* CircBuf32_GetBufPtr(circ_buf32_t *ptr);
+
+// получить указатель на длину данных
+uint32_t* CircBuf32_GetDataLenPtr(circ_buf32_t *ptr);
+
+// получить указатель на стартовый индекс
+uint32_t* CircBuf32_GetStartIndexPtr(circ_buf32_t *ptr);
+
+// добавить данные в кольцевой буфер
+circ_buf_error_code_t CircBuf32_AddData(circ_buf32_t *ptr, uint8_t* data, uint32_t len);
+
+// добавить данные в кольцевой буфер потокобезопасно
+circ_buf_error_code_t CircBuf32_AddDataProtected(circ_buf32_t *ptr, uint8_t* data, uint32_t len);
+
+// установить стартовый индекс (удаляет данные из буфера путем переноса стартового индекса)
+void CircBuf32_SetStartInd(circ_buf32_t *ptr, uint32_t index);
+
+// прочитать данные из буфера (не более max_len), возвращает число прочитанных байт
+uint32_t CircBuf32_ReadData(circ_buf32_t *ptr, uint8_t *dst, uint32_t max_len);
+
+// удалить данные из буфера (не более len), возвращает число удалённых байт
+uint32_t CircBuf32_Skip(circ_buf32_t *ptr, uint32_t len);
+
+// увеличить индекс
+uint32_t CircBuf32_AddIndValue(circ_buf32_t *ptr, uint32_t val, uint32_t add);
+
+// увеличить индекс
+uint32_t CircBuf32_IncIndValue(circ_buf32_t *ptr, uint32_t val);
+
+// получить длинну данных мжду заданными индексами
+uint32_t CircBuf32_GetDataLenBetweenIndexes(circ_buf32_t *ptr, uint32_t start_ind, uint32_t end_ind);
+
+// скопировать данные между индексами
+uint32_t CircBuf32_DataCopyBetweenIndexes(circ_buf32_t *ptr, uint8_t *dst, uint32_t start_ind, uint32_t end_ind);
+
+// Установить данные между индексами
+uint32_t CircBuf32_DataSetBetweenIndexes(circ_buf32_t *ptr, uint8_t val, uint32_t start_ind, uint32_t end_ind);
+
+
+
+#endif /* APPLICATION_SUPPORTLIBS_CIRCBUF32_H_ */
@@ -0,0 +1,306 @@
+/**************************************************************************//**
+ * @file      CircBufBcast.c
+ * @brief     Broadcast circular buffer: one producer, several reader cursors. Source file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "CircBufBcast.h"
+
+
+// максимальное заполнение относительно обязательных читателей
+static uint32_t Private_CircBufBcast_GetFill(circ_buf_bcast_t *p, uint32_t end_ind);
+
+// скопировать len байт из буфера начиная с индекса
+static void Private_CircBufBcast_CopyOut(circ_buf_bcast_t *p, uint8_t *dst, uint32_t ind, uint32_t len);
+
+
+// инициализация, длина буфера - степень двойки
+circ_buf_error_code_t CircBufBcast_Init(circ_buf_bcast_t *p, uint8_t *buf_ptr, uint32_t buf_len)
+{
+	if((p == NULL) || (buf_ptr == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	if((buf_len == 0) || (buf_len & (buf_len - 1)) || (buf_len > 0x80000000))
+		return CIRC_BUF__WRONG_ARG;
+
+	memset(p, 0, sizeof(circ_buf_bcast_t));
+
+	p->buf_ptr  = buf_ptr;
+	p->buf_len  = buf_len;
+	p->ind_mask = buf_len - 1;
+
+	return CIRC_BUF__OK;
+}
+
+
+// зарегистрировать читателя
+circ_buf_error_code_t CircBufBcast_AddReader(circ_buf_bcast_t *p, uint8_t lossy, uint8_t *rd_id)
+{
+	uint32_t s;
+
+	if((p == NULL) || (rd_id == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	ENTER_CRITICAL(s);
+
+	for(uint8_t i = 0; i < CIRC_BUF_BCAST_RD_NUM; i++)
+	{
+		if(p->rd[i].used)
+			continue;
+
+		p->rd[i].ind = p->end_ind;
+		p->rd[i].lossy = lossy;
+		p->rd[i].lost_bytes = 0;
+		MEM_BARRIER();                                                          // курсор заполнен до публикации
+		p->rd[i].used = 1;
+
+		LEAVE_CRITICAL(s);
+
+		*rd_id = i;
+		return CIRC_BUF__OK;
+	}
+
+	LEAVE_CRITICAL(s);
+
+	return CIRC_BUF__OVF;
+}
+
+
+// удалить читателя
+void CircBufBcast_RemoveReader(circ_buf_bcast_t *p, uint8_t rd_id)
+{
+	if((p == NULL) || (rd_id >= CIRC_BUF_BCAST_RD_NUM))
+		return;
+
+	p->rd[rd_id].used = 0;
+}
+
+
+// получить свободное место (писатель)
+uint32_t CircBufBcast_GetFreeLen(circ_buf_bcast_t *p)
+{
+	if(p == NULL)
+		return 0;
+
+	return p->buf_len - Private_CircBufBcast_GetFill(p, p->end_ind);
+}
+
+
+// добавить данные (писатель)
+// граница wr_ind объявляется до копирования: необязательный читатель после чтения сверяется с ней
+// и отбрасывает то, что писатель мог перезаписать во время копирования
+circ_buf_error_code_t CircBufBcast_AddData(circ_buf_bcast_t *p, uint8_t *data, uint32_t len)
+{
+	uint32_t end_ind;
+	uint32_t pos;
+	uint32_t len_to_border;
+
+	if((p == NULL) || (data == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	if(len == 0)
+		return CIRC_BUF__WRONG_ARG;
+
+	end_ind = p->end_ind;
+
+	// проверка на переполение буфера по самому медленному обязательному читателю
+	if(len > p->buf_len - Private_CircBufBcast_GetFill(p, end_ind))
+	{
+		p->ovf_err_cnt++;
+		p->lost_bytes += len;
+
+		return CIRC_BUF__OVF;
+	}
+
+	p->wr_ind = end_ind + len;
+	MEM_BARRIER();                                                              // граница объявлена до записи
+
+	pos = end_ind & p->ind_mask;                                                // позиция записи в буфере
+	len_to_border = p->buf_len - pos;                                           // расстояние до границы буфера
+
+	// если данные не пересекают границу
+	if(len <= len_to_border)
+	{
+		memcpy(&p->buf_ptr[pos], data, len);                                    // копируем данные
+	}else                                                                       // если данные пересекают границу
+	{
+		memcpy(&p->buf_ptr[pos], data, len_to_border);                          // копируем до границы
+		memcpy(&p->buf_ptr[0], &data[len_to_border], len - len_to_border);      // копируем оставшиеся данные
+	}
+
+	MEM_BARRIER();                                                              // данные записаны до публикации
+	p->end_ind = end_ind + len;
+
+	return CIRC_BUF__OK;
+}
+
+
+// получить число данных, доступных читателю
+uint32_t CircBufBcast_GetDataLen(circ_buf_bcast_t *p, uint8_t rd_id)
+{
+	uint32_t len;
+
+	if((p == NULL) || (rd_id >= CIRC_BUF_BCAST_RD_NUM) || !p->rd[rd_id].used)
+		return 0;
+
+	len = p->end_ind - p->rd[rd_id].ind;
+	MEM_BARRIER();                                                              // данные читаются после индекса
+
+	if(len > p->buf_len)                                                        // необязательного читателя обогнали
+		len = p->buf_len;
+
+	return len;
+}
+
+
+// прочитать данные (не более max_len), возвращает число прочитанных байт
+uint32_t CircBufBcast_ReadData(circ_buf_bcast_t *p, uint8_t rd_id, uint8_t *dst, uint32_t max_len)
+{
+	circ_buf_bcast_rd_t *rd;
+	uint32_t ind;
+	uint32_t len;
+	uint32_t lost;
+
+	if((p == NULL) || (dst == NULL) || (rd_id >= CIRC_BUF_BCAST_RD_NUM))
+		return 0;
+
+	rd = &p->rd[rd_id];
+	if(!rd->used)
+		return 0;
+
+	ind = rd->ind;
+
+	while(1)
+	{
+		len = p->end_ind - ind;
+		MEM_BARRIER();                                                          // данные читаются после индекса
+
+		// писатель обогнал читателя на круг, пропускаем перезаписанное
+		if(len > p->buf_len)
+		{
+			lost = len - p->buf_len;
+			rd->lost_bytes += lost;
+			ind += lost;
+			len = p->buf_len;
+		}
+
+		if(len > max_len)
+			len = max_len;
+
+		if(len == 0)
+			return 0;
+
+		Private_CircBufBcast_CopyOut(p, dst, ind, len);                         // копируем данные
+
+		if(!rd->lossy)                                                          // обязательного читателя писатель не обгоняет
+			break;
+
+		// байты ниже wr_ind - buf_len могли быть перезаписаны во время копирования
+		MEM_BARRIER();
+		lost = p->wr_ind - p->buf_len - ind;
+		if((int32_t)lost <= 0)
+			break;
+
+		rd->lost_bytes += lost;
+		ind += lost;
+
+		if(lost < len)
+		{
+			len -= lost;
+			memmove(dst, &dst[lost], len);
+			break;
+		}
+		// всё скопированное перезаписано, повторяем
+	}
+
+	MEM_BARRIER();                                                              // данные прочитаны до освобождения места
+	rd->ind = ind + len;
+
+	return len;
+}
+
+
+// удалить данные читателя (не более len), возвращает число удалённых байт
+uint32_t CircBufBcast_Skip(circ_buf_bcast_t *p, uint8_t rd_id, uint32_t len)
+{
+	uint32_t data_len;
+	uint32_t end_ind;
+
+	if((p == NULL) || (rd_id >= CIRC_BUF_BCAST_RD_NUM) || !p->rd[rd_id].used)
+		return 0;
+
+	end_ind = p->end_ind;
+	data_len = end_ind - p->rd[rd_id].ind;
+
+	if(data_len > p->buf_len)                                                   // необязательного читателя обогнали
+	{
+		p->rd[rd_id].lost_bytes += data_len - p->buf_len;
+		p->rd[rd_id].ind = end_ind - p->buf_len;
+		data_len = p->buf_len;
+	}
+
+	if(len > data_len)
+		len = data_len;
+
+	MEM_BARRIER();
+	p->rd[rd_id].ind += len;
+
+	return len;
+}
+
+
+// максимальное заполнение относительно обязательных читателей
+static uint32_t Private_CircBufBcast_GetFill(circ_buf_bcast_t *p, uint32_t end_ind)
+{
+	uint32_t fill = 0;
+	uint32_t len;
+
+	for(uint8_t i = 0; i < CIRC_BUF_BCAST_RD_NUM; i++)
+	{
+		if(!p->rd[i].used || p->rd[i].lossy)
+			continue;
+
+		len = end_ind - p->rd[i].ind;
+		if(len > fill)
+			fill = len;
+	}
+
+	MEM_BARRIER();                                                              // место освобождается после чтения индексов
+
+	return fill;
+}
+
+
+// скопировать len байт из буфера начиная с индекса
+static void Private_CircBufBcast_CopyOut(circ_buf_bcast_t *p, uint8_t *dst, uint32_t ind, uint32_t len)
+{
+	uint32_t pos = ind & p->ind_mask;                                           // позиция чтения в буфере
+	uint32_t len_to_border = p->buf_len - pos;                                  // расстояние до границы буфера
+
+	// если данные не пересекают границу
+	if(len <= len_to_border)
+	{
+		memcpy(dst, &p->buf_ptr[pos], len);                                     // копируем данные
+	}else                                                                       // если данные пересекают границу
+	{
+		memcpy(dst, &p->buf_ptr[pos], len_to_border);                           // копируем до границы
+		memcpy(&dst[len_to_border], &p->buf_ptr[0], len - len_to_border);       // копируем оставшиеся данные
+	}
+}
@@ -0,0 +1,95 @@
+/**************************************************************************//**
+ * @file      CircBufBcast.h
+ * @brief     Broadcast circular buffer: one producer, several reader cursors. Header file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef APPLICATION_SUPPORTLIBS_CIRCBUFBCAST_H_
+#define APPLICATION_SUPPORTLIBS_CIRCBUFBCAST_H_
+
+
+#include "CircBuf.h"                    // коды ошибок
+
+
+#ifndef CIRC_BUF_BCAST_RD_NUM
+#define CIRC_BUF_BCAST_RD_NUM   4       // максимальное число читателей
+#endif
+
+
+// курсор читателя
+typedef struct
+{
+	volatile uint32_t ind;                 // индекс чтения, свободно бегущий
+	volatile uint8_t used;                 // курсор зарегистрирован
+	uint8_t lossy;                         // 1 - писатель может обогнать читателя на круг, данные теряются
+
+	uint32_t lost_bytes;                   // потеряно байт (обгон писателем)
+
+} circ_buf_bcast_rd_t;
+
+
+// кольцевой буфер с одним писателем и несколькими независимыми читателями
+// место освобождается, когда его прошёл самый медленный обязательный читатель,
+// необязательные (lossy) читатели писателя не задерживают
+typedef struct
+{
+	uint8_t* buf_ptr;                      // указатель на буфер
+	uint32_t buf_len;                      // длина буфера (степень двойки)
+	uint32_t ind_mask;                     // маска позиции в буфере
+
+	volatile uint32_t wr_ind;              // граница записываемых данных, объявляется до копирования (писатель)
+	volatile uint32_t end_ind;             // конечный индекс данных, публикуется после копирования (писатель)
+
+	circ_buf_bcast_rd_t rd[CIRC_BUF_BCAST_RD_NUM];  // курсоры читателей
+
+	uint32_t ovf_err_cnt;                  // счётчик переполнения буфера
+	uint32_t lost_bytes;                   // потеряно байт писателем
+
+} circ_buf_bcast_t;
+
+
+// инициализация, длина буфера - степень двойки
+circ_buf_error_code_t CircBufBcast_Init(circ_buf_bcast_t *p, uint8_t *buf_ptr, uint32_t buf_len);
+
+// зарегистрировать читателя, чтение начинается с текущего конца данных
+// lossy = 1 - необязательный читатель, rd_id - номер курсора
+circ_buf_error_code_t CircBufBcast_AddReader(circ_buf_bcast_t *p, uint8_t lossy, uint8_t *rd_id);
+
+// удалить читателя
+void CircBufBcast_RemoveReader(circ_buf_bcast_t *p, uint8_t rd_id);
+
+// получить свободное место (писатель)
+uint32_t CircBufBcast_GetFreeLen(circ_buf_bcast_t *p);
+
+// добавить данные (писатель)
+circ_buf_error_code_t CircBufBcast_AddData(circ_buf_bcast_t *p, uint8_t *data, uint32_t len);
+
+// получить число данных, доступных читателю
+uint32_t CircBufBcast_GetDataLen(circ_buf_bcast_t *p, uint8_t rd_id);
+
+// прочитать данные (не более max_len), возвращает число прочитанных байт
+// если писатель обогнал необязательного читателя, пропущенные данные учитываются в rd[].lost_bytes
+uint32_t CircBufBcast_ReadData(circ_buf_bcast_t *p, uint8_t rd_id, uint8_t *dst, uint32_t max_len);
+
+// удалить данные читателя (не более len), возвращает число удалённых байт
+uint32_t CircBufBcast_Skip(circ_buf_bcast_t *p, uint8_t rd_id, uint32_t len);
+
+
+
+#endif /* APPLICATION_SUPPORTLIBS_CIRCBUFBCAST_H_ */
@@ -0,0 +1,111 @@
+/**************************************************************************//**
+ * @file      CircBufMirror.c
+ * @brief     Double-mapped (mirror) circular buffer for Linux. Source file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#if defined(__linux__)
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE                     // memfd_create
+#endif
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "CircBufMirror.h"
+
+
+// инициализация с установкой CIRC_BUF_MODE_MIRROR (CircBuf.c), в CircBuf.h не объявлена
+circ_buf_error_code_t Private_CircBuf_Init(circ_buf_t *ptr, circ_buf_init_t *init, uint8_t mirror);
+
+
+// инициализация кольцевого буфера с двойным отображением страниц
+circ_buf_error_code_t CircBufMirror_Init(circ_buf_t *ptr, circ_buf_init_t *init)
+{
+	circ_buf_init_t mirror_init;
+	circ_buf_error_code_t res;
+	long page_size;
+	uint8_t* base;
+	size_t len;
+	int fd;
+
+	if((ptr == NULL) || (init == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	page_size = sysconf(_SC_PAGESIZE);
+	if((page_size <= 0) || (init->buf_len == 0) || (init->buf_len % page_size))
+		return CIRC_BUF__WRONG_ARG;
+
+	if(init->mode & CIRC_BUF_MODE_DMA)                                          // DMA пишет в физический буфер, копия не нужна
+		return CIRC_BUF__WRONG_ARG;
+
+	len = init->buf_len;
+
+	fd = memfd_create("circbuf", MFD_CLOEXEC);
+	if(fd < 0)
+		return CIRC_BUF__ALLOC_ERR;
+
+	if(ftruncate(fd, len) != 0)
+	{
+		close(fd);
+		return CIRC_BUF__ALLOC_ERR;
+	}
+
+	// резервируем окно двойной длины, затем отображаем в обе половины одни и те же страницы
+	base = mmap(NULL, 2 * len, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(base == MAP_FAILED)
+	{
+		close(fd);
+		return CIRC_BUF__ALLOC_ERR;
+	}
+
+	if((mmap(base, len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) ||
+	   (mmap(base + len, len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED))
+	{
+		munmap(base, 2 * len);
+		close(fd);
+		return CIRC_BUF__ALLOC_ERR;
+	}
+
+	close(fd);                                                                  // отображения удерживают память
+
+	// структура вызывающего не изменяется
+	mirror_init = *init;
+	mirror_init.buf_ptr = base;
+
+	res = Private_CircBuf_Init(ptr, &mirror_init, 1);                          // отображение построено, включаем MIRROR
+	if(res != CIRC_BUF__OK)
+		munmap(base, 2 * len);
+
+	return res;
+}
+
+
+// освободить память буфера, выделенную CircBufMirror_Init
+void CircBufMirror_Free(circ_buf_t *ptr)
+{
+	if((ptr == NULL) || (ptr->buf_ptr == NULL) || !(ptr->mode & CIRC_BUF_MODE_MIRROR))
+		return;
+
+	munmap(ptr->buf_ptr, 2 * (size_t)ptr->buf_len);
+	ptr->buf_ptr = NULL;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,45 @@
+/**************************************************************************//**
+ * @file      CircBufMirror.h
+ * @brief     Double-mapped (mirror) circular buffer for Linux. Header file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef APPLICATION_SUPPORTLIBS_CIRCBUFMIRROR_H_
+#define APPLICATION_SUPPORTLIBS_CIRCBUFMIRROR_H_
+
+
+#include "CircBuf.h"
+
+
+#if defined(__linux__)
+
+// инициализация кольцевого буфера с двойным отображением страниц
+// память выделяется через memfd_create и отображается дважды подряд, поэтому любой участок
+// [start, start + len) непрерывен в памяти; init->buf_ptr игнорируется, init->buf_len должна быть кратна
+// размеру страницы, к режиму init->mode добавляется CIRC_BUF_MODE_MIRROR; структура init не изменяется
+circ_buf_error_code_t CircBufMirror_Init(circ_buf_t *ptr, circ_buf_init_t *init);
+
+// освободить память буфера, выделенную CircBufMirror_Init
+void CircBufMirror_Free(circ_buf_t *ptr);
+
+#endif /* __linux__ */
+
+
+
+#endif /* APPLICATION_SUPPORTLIBS_CIRCBUFMIRROR_H_ */
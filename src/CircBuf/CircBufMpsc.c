@@ -0,0 +1,298 @@
+/**************************************************************************//**
+ * @file      CircBufMpsc.c
+ * @brief     Multi-producer single-consumer circular buffer. Source file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "CircBufMpsc.h"
+
+
+// адрес заголовка участка по индексу начала данных
+static volatile uint32_t* Private_CircBufMpsc_Hdr(circ_buf_mpsc_t *p, uint32_t ind);
+
+// продвинуть конец цепочки по зафиксированным участкам (читатель)
+static void Private_CircBufMpsc_Walk(circ_buf_mpsc_t *p);
+
+// скопировать участок буфера с учётом границы
+static void Private_CircBufMpsc_CopyOut(circ_buf_mpsc_t *p, uint8_t *dst, uint32_t ind, uint32_t len);
+
+// прочитать или удалить данные (dst == NULL) из цепочки зафиксированных участков
+static uint32_t Private_CircBufMpsc_Consume(circ_buf_mpsc_t *p, uint8_t *dst, uint32_t max_len);
+
+// освободить прочитанный участок: обнулить занятое им место и сдвинуть начальный индекс
+static void Private_CircBufMpsc_Release(circ_buf_mpsc_t *p, uint32_t resv_len);
+
+
+// инициализация, длина буфера - степень двойки
+circ_buf_error_code_t CircBufMpsc_Init(circ_buf_mpsc_t *p, uint8_t *buf_ptr, uint32_t buf_len)
+{
+	if((p == NULL) || (buf_ptr == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	if((buf_len < 8) || (buf_len & (buf_len - 1)) || (buf_len > 0x80000000) || ((uintptr_t)buf_ptr & 3))
+		return CIRC_BUF__WRONG_ARG;
+
+	memset(p, 0, sizeof(circ_buf_mpsc_t));
+	memset(buf_ptr, 0, buf_len);                                                // все заголовки не зафиксированы
+
+	p->buf_ptr  = buf_ptr;
+	p->buf_len  = buf_len;
+	p->ind_mask = buf_len - 1;
+
+	return CIRC_BUF__OK;
+}
+
+
+// зарезервировать участок длиной len (писатель)
+circ_buf_error_code_t CircBufMpsc_Reserve(circ_buf_mpsc_t *p, uint32_t len, circ_buf_mpsc_resv_t *resv)
+{
+	uint32_t ind;
+	uint32_t start_ind;
+	uint32_t resv_len;
+
+	if((p == NULL) || (resv == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	if((len == 0) || (len > p->buf_len - CIRC_BUF_MPSC_HDR_LEN))
+		return CIRC_BUF__WRONG_ARG;
+
+	resv_len = CIRC_BUF_MPSC_RESV_LEN(len);
+
+	while(1)
+	{
+		// начальный индекс читаем первым: между чтениями читатель мог его сдвинуть, а писатели
+		// зарезервировать больше, тогда снимок несогласован и его нужно взять заново
+		start_ind = p->start_ind;
+		MEM_BARRIER();
+		ind = p->resv_ind;
+
+		if(ind - start_ind > p->buf_len)
+			continue;
+
+		// проверка на переполение буфера
+		if(resv_len > p->buf_len - (ind - start_ind))
+		{
+			ATOMIC_ADD32(&p->ovf_err_cnt, 1);
+			ATOMIC_ADD32(&p->lost_bytes, len);
+
+			return CIRC_BUF__OVF;
+		}
+
+		if(ATOMIC_CAS32(&p->resv_ind, ind, ind + resv_len))                     // другой писатель мог успеть раньше
+			break;
+	}
+
+	resv->ind = ind + CIRC_BUF_MPSC_HDR_LEN;
+	resv->len = len;
+
+	return CIRC_BUF__OK;
+}
+
+
+// скопировать данные в зарезервированный участок (писатель)
+void CircBufMpsc_WriteResv(circ_buf_mpsc_t *p, circ_buf_mpsc_resv_t *resv, uint8_t *data)
+{
+	uint32_t pos;
+	uint32_t len_to_border;
+
+	if((p == NULL) || (resv == NULL) || (data == NULL))
+		return;
+
+	pos = resv->ind & p->ind_mask;                                              // позиция записи в буфере
+	len_to_border = p->buf_len - pos;                                           // расстояние до границы буфера
+
+	// если данные не пересекают границу
+	if(resv->len <= len_to_border)
+	{
+		memcpy(&p->buf_ptr[pos], data, resv->len);                              // копируем данные
+	}else                                                                       // если данные пересекают границу
+	{
+		memcpy(&p->buf_ptr[pos], data, len_to_border);                          // копируем до границы
+		memcpy(&p->buf_ptr[0], &data[len_to_border], resv->len - len_to_border);// копируем оставшиеся данные
+	}
+}
+
+
+// зафиксировать заполненный участок (писатель)
+void CircBufMpsc_Commit(circ_buf_mpsc_t *p, circ_buf_mpsc_resv_t *resv)
+{
+	if((p == NULL) || (resv == NULL))
+		return;
+
+	MEM_BARRIER();                                                              // данные записаны до фиксации
+	*Private_CircBufMpsc_Hdr(p, resv->ind) = resv->len;                         // одна выровненная запись слова
+}
+
+
+// добавить данные: резервирование, копирование и фиксация (писатель)
+circ_buf_error_code_t CircBufMpsc_AddData(circ_buf_mpsc_t *p, uint8_t *data, uint32_t len)
+{
+	circ_buf_mpsc_resv_t resv;
+	circ_buf_error_code_t ret;
+
+	if(data == NULL)
+		return CIRC_BUF__NULL_POINTER;
+
+	ret = CircBufMpsc_Reserve(p, len, &resv);
+	if(ret != CIRC_BUF__OK)
+		return ret;
+
+	CircBufMpsc_WriteResv(p, &resv, data);
+	CircBufMpsc_Commit(p, &resv);
+
+	return CIRC_BUF__OK;
+}
+
+
+// получить число данных, доступных читателю
+uint32_t CircBufMpsc_GetDataLen(circ_buf_mpsc_t *p)
+{
+	if(p == NULL)
+		return 0;
+
+	Private_CircBufMpsc_Walk(p);
+
+	return p->ready_len;
+}
+
+
+// прочитать данные (не более max_len), возвращает число прочитанных байт
+uint32_t CircBufMpsc_ReadData(circ_buf_mpsc_t *p, uint8_t *dst, uint32_t max_len)
+{
+	if((p == NULL) || (dst == NULL))
+		return 0;
+
+	return Private_CircBufMpsc_Consume(p, dst, max_len);
+}
+
+
+// удалить данные (не более len), возвращает число удалённых байт
+uint32_t CircBufMpsc_Skip(circ_buf_mpsc_t *p, uint32_t len)
+{
+	if(p == NULL)
+		return 0;
+
+	return Private_CircBufMpsc_Consume(p, NULL, len);
+}
+
+
+
+
+// адрес заголовка участка по индексу начала данных
+// заголовки выровнены на 4 байта и не пересекают границу буфера: все участки кратны 4 байтам
+static volatile uint32_t* Private_CircBufMpsc_Hdr(circ_buf_mpsc_t *p, uint32_t ind)
+{
+	return (volatile uint32_t*)&p->buf_ptr[(ind - CIRC_BUF_MPSC_HDR_LEN) & p->ind_mask];
+}
+
+
+// продвинуть конец цепочки по зафиксированным участкам (читатель)
+// ненулевой заголовок записывается писателем только при фиксации, остальное место обнулено читателем
+static void Private_CircBufMpsc_Walk(circ_buf_mpsc_t *p)
+{
+	uint32_t len;
+
+	// полный буфер: конец цепочки совпал с началом по позиции, дальше идут уже пройденные участки
+	while(p->ready_ind - p->start_ind < p->buf_len)
+	{
+		len = *Private_CircBufMpsc_Hdr(p, p->ready_ind + CIRC_BUF_MPSC_HDR_LEN);
+		if(len == 0)                                                            // участок не зафиксирован или свободен
+			break;
+
+		p->ready_ind += CIRC_BUF_MPSC_RESV_LEN(len);
+		p->ready_len += len;
+	}
+
+	MEM_BARRIER();                                                              // данные читаются после заголовков
+}
+
+
+// скопировать участок буфера с учётом границы
+static void Private_CircBufMpsc_CopyOut(circ_buf_mpsc_t *p, uint8_t *dst, uint32_t ind, uint32_t len)
+{
+	uint32_t pos = ind & p->ind_mask;                                           // позиция чтения в буфере
+	uint32_t len_to_border = p->buf_len - pos;                                  // расстояние до границы буфера
+
+	// если данные не пересекают границу
+	if(len <= len_to_border)
+	{
+		memcpy(dst, &p->buf_ptr[pos], len);                                     // копируем данные
+	}else                                                                       // если данные пересекают границу
+	{
+		memcpy(dst, &p->buf_ptr[pos], len_to_border);                           // копируем до границы
+		memcpy(&dst[len_to_border], &p->buf_ptr[0], len - len_to_border);       // копируем оставшиеся данные
+	}
+}
+
+
+// прочитать или удалить данные (dst == NULL) из цепочки зафиксированных участков
+static uint32_t Private_CircBufMpsc_Consume(circ_buf_mpsc_t *p, uint8_t *dst, uint32_t max_len)
+{
+	uint32_t done = 0;
+	uint32_t hdr_len;
+	uint32_t part;
+
+	Private_CircBufMpsc_Walk(p);
+
+	while((done < max_len) && (p->ready_len != 0))
+	{
+		hdr_len = *Private_CircBufMpsc_Hdr(p, p->start_ind + CIRC_BUF_MPSC_HDR_LEN);
+
+		part = hdr_len - p->rd_off;                                             // остаток текущего участка
+		if(part > max_len - done)
+			part = max_len - done;
+
+		if(dst != NULL)
+			Private_CircBufMpsc_CopyOut(p, &dst[done], p->start_ind + CIRC_BUF_MPSC_HDR_LEN + p->rd_off, part);
+
+		done += part;
+		p->rd_off += part;
+		p->ready_len -= part;
+
+		if(p->rd_off == hdr_len)                                                // участок прочитан полностью
+		{
+			p->rd_off = 0;
+			Private_CircBufMpsc_Release(p, CIRC_BUF_MPSC_RESV_LEN(hdr_len));
+		}
+	}
+
+	return done;
+}
+
+
+// освободить прочитанный участок: обнулить занятое им место и сдвинуть начальный индекс
+// обнуление нужно, чтобы будущий заголовок на этом месте не выглядел зафиксированным до записи писателем
+static void Private_CircBufMpsc_Release(circ_buf_mpsc_t *p, uint32_t resv_len)
+{
+	uint32_t pos = p->start_ind & p->ind_mask;
+	uint32_t len_to_border = p->buf_len - pos;
+
+	if(resv_len <= len_to_border)
+	{
+		memset(&p->buf_ptr[pos], 0, resv_len);
+	}else
+	{
+		memset(&p->buf_ptr[pos], 0, len_to_border);
+		memset(&p->buf_ptr[0], 0, resv_len - len_to_border);
+	}
+
+	MEM_BARRIER();                                                              // место обнулено до освобождения
+	p->start_ind += resv_len;
+}
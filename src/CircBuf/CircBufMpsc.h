@@ -0,0 +1,95 @@
+/**************************************************************************//**
+ * @file      CircBufMpsc.h
+ * @brief     Multi-producer single-consumer circular buffer. Header file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef APPLICATION_SUPPORTLIBS_CIRCBUFMPSC_H_
+#define APPLICATION_SUPPORTLIBS_CIRCBUFMPSC_H_
+
+
+#include "CircBuf.h"                    // коды ошибок
+
+
+#define CIRC_BUF_MPSC_HDR_LEN   4       // длина заголовка участка, байт
+
+// место в буфере, занимаемое участком с len байт данных: заголовок и данные, выровненные до 4 байт
+#define CIRC_BUF_MPSC_RESV_LEN(len)   (CIRC_BUF_MPSC_HDR_LEN + (((len) + 3) & ~3UL))
+
+
+// кольцевой буфер для нескольких писателей и одного читателя без запрета прерываний
+// писатели резервируют место через CAS и заполняют его параллельно; перед данными участка лежит заголовок -
+// длина данных, которую писатель записывает при фиксации (0 - участок не зафиксирован);
+// читатель проходит по заголовкам от начала данных и читает непрерывную цепочку зафиксированных участков,
+// не дожидаясь остальных писателей; прочитанное место читатель обнуляет, поэтому свободное место
+// и незафиксированные участки всегда содержат нулевой заголовок
+typedef struct
+{
+	uint8_t* buf_ptr;                      // указатель на буфер (выровнен на 4 байта)
+	uint32_t buf_len;                      // длина буфера (степень двойки, не менее 8)
+	uint32_t ind_mask;                     // маска позиции в буфере
+
+	volatile uint32_t resv_ind;            // индекс резервирования, свободно бегущий (писатели)
+	volatile uint32_t start_ind;           // индекс заголовка текущего участка, свободно бегущий (читатель)
+	uint32_t rd_off;                       // прочитано байт данных текущего участка (читатель)
+	uint32_t ready_ind;                    // конец цепочки зафиксированных участков (читатель)
+	uint32_t ready_len;                    // непрочитанных байт данных в цепочке (читатель)
+
+	volatile uint32_t ovf_err_cnt;         // счётчик переполнения буфера
+	volatile uint32_t lost_bytes;          // потеряно байт
+
+} circ_buf_mpsc_t;
+
+
+// зарезервированный писателем участок
+typedef struct
+{
+	uint32_t ind;                          // индекс начала данных участка (заголовок перед ним)
+	uint32_t len;                          // длина данных участка
+
+} circ_buf_mpsc_resv_t;
+
+
+// инициализация, длина буфера - степень двойки не менее 8, буфер обнуляется
+circ_buf_error_code_t CircBufMpsc_Init(circ_buf_mpsc_t *p, uint8_t *buf_ptr, uint32_t buf_len);
+
+// зарезервировать участок с len байт данных (писатель), занимает CIRC_BUF_MPSC_RESV_LEN(len) байт буфера
+circ_buf_error_code_t CircBufMpsc_Reserve(circ_buf_mpsc_t *p, uint32_t len, circ_buf_mpsc_resv_t *resv);
+
+// скопировать данные в зарезервированный участок (писатель)
+void CircBufMpsc_WriteResv(circ_buf_mpsc_t *p, circ_buf_mpsc_resv_t *resv, uint8_t *data);
+
+// зафиксировать заполненный участок (писатель)
+void CircBufMpsc_Commit(circ_buf_mpsc_t *p, circ_buf_mpsc_resv_t *resv);
+
+// добавить данные: резервирование, копирование и фиксация (писатель)
+circ_buf_error_code_t CircBufMpsc_AddData(circ_buf_mpsc_t *p, uint8_t *data, uint32_t len);
+
+// получить число данных, доступных читателю (без заголовков и выравнивания)
+uint32_t CircBufMpsc_GetDataLen(circ_buf_mpsc_t *p);
+
+// прочитать данные (не более max_len), возвращает число прочитанных байт
+uint32_t CircBufMpsc_ReadData(circ_buf_mpsc_t *p, uint8_t *dst, uint32_t max_len);
+
+// удалить данные (не более len), возвращает число удалённых байт
+uint32_t CircBufMpsc_Skip(circ_buf_mpsc_t *p, uint32_t len);
+
+
+
+#endif /* APPLICATION_SUPPORTLIBS_CIRCBUFMPSC_H_ */
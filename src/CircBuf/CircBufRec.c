@@ -0,0 +1,214 @@
+/**************************************************************************//**
+ * @file      CircBufRec.c
+ * @brief     Length-prefixed record ring based on circular buffer. Source file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "CircBufRec.h"
+
+
+// инициализация
+circ_buf_error_code_t CircBufRec_Init(circ_buf_rec_t *p, circ_buf_init_t *init)
+{
+	if((p == NULL) || (init == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	// писатель должен управлять границами записей
+	if(init->mode & (CIRC_BUF_MODE_DMA | CIRC_BUF_MODE_OVERWRITE))
+		return CIRC_BUF__WRONG_ARG;
+
+	p->resv_len = 0;
+	p->reserved = 0;
+	p->peek_len = 0;
+
+	return CircBuf_Init(&p->cb, init);
+}
+
+
+// зарезервировать место под запись длиной len, возвращает указатель на данные записи или NULL
+uint8_t* CircBufRec_Reserve(circ_buf_rec_t *p, uint16_t len)
+{
+	uint8_t *span;
+	uint16_t span_len;
+	uint16_t len_to_border;
+	uint32_t need;
+
+	if(p == NULL)
+		return NULL;
+
+	p->reserved = 0;                                                            // неудачный резерв отменяет предыдущий
+
+	need = (uint32_t)len + CIRC_BUF_REC_HDR_LEN;
+
+	span = CircBuf_GetWriteSpan(&p->cb, &span_len);
+	if(span == NULL)
+		return NULL;
+
+	// запись не помещается до границы буфера
+	if(span_len < need)
+	{
+		len_to_border = CircBuf_GetBufLen(&p->cb) - (uint16_t)(span - CircBuf_GetBufPtr(&p->cb));
+
+		// место есть только если свободный участок упирается в границу, а после неё хватает места
+		if((span_len != len_to_border) || ((uint32_t)CircBuf_GetFreeLen(&p->cb) < len_to_border + need))
+		{
+			p->cb.ovf_err_cnt++;
+			p->cb.lost_bytes += len;
+			return NULL;
+		}
+
+		// заполнитель до границы, при остатке меньше заголовка читатель пропустит его сам
+		if(len_to_border >= CIRC_BUF_REC_HDR_LEN)
+		{
+			uint16_t pad = CIRC_BUF_REC_PAD;
+			memcpy(span, &pad, CIRC_BUF_REC_HDR_LEN);
+		}
+		CircBuf_CommitWrite(&p->cb, len_to_border);
+
+		span = CircBuf_GetWriteSpan(&p->cb, &span_len);
+	}
+
+	p->resv_len = len;
+	p->reserved = 1;
+
+	return &span[CIRC_BUF_REC_HDR_LEN];
+}
+
+
+// зафиксировать зарезервированную запись, len - фактическая длина (не больше зарезервированной)
+circ_buf_error_code_t CircBufRec_Commit(circ_buf_rec_t *p, uint16_t len)
+{
+	uint8_t *span;
+	uint16_t span_len;
+
+	if(p == NULL)
+		return CIRC_BUF__NULL_POINTER;
+
+	if(!p->reserved || (len > p->resv_len))
+		return CIRC_BUF__WRONG_ARG;
+
+	span = CircBuf_GetWriteSpan(&p->cb, &span_len);
+	if(span == NULL)
+		return CIRC_BUF__NULL_POINTER;
+
+	// запись должна целиком помещаться в непрерывный свободный участок
+	if(span_len < (uint32_t)len + CIRC_BUF_REC_HDR_LEN)
+		return CIRC_BUF__WRONG_ARG;
+
+	memcpy(span, &len, CIRC_BUF_REC_HDR_LEN);                                   // заголовок пишем последним
+	p->resv_len = 0;
+	p->reserved = 0;
+
+	return CircBuf_CommitWrite(&p->cb, len + CIRC_BUF_REC_HDR_LEN);             // публикуем запись целиком
+}
+
+
+// получить указатель на данные самой старой записи без копирования или NULL, если записей нет
+uint8_t* CircBufRec_Peek(circ_buf_rec_t *p, uint16_t *len)
+{
+	uint8_t *span;
+	uint16_t span_len;
+	uint16_t rec_len;
+
+	if((p == NULL) || (len == NULL))
+		return NULL;
+
+	while(1)
+	{
+		span = CircBuf_GetReadSpan(&p->cb, &span_len);
+		if((span == NULL) || (span_len == 0))
+			return NULL;
+
+		// остаток до границы меньше заголовка - неявный заполнитель
+		if(span_len < CIRC_BUF_REC_HDR_LEN)
+		{
+			CircBuf_Skip(&p->cb, span_len);
+			continue;
+		}
+
+		memcpy(&rec_len, span, CIRC_BUF_REC_HDR_LEN);
+
+		// заполнитель занимает всё место до границы буфера
+		if(rec_len == CIRC_BUF_REC_PAD)
+		{
+			CircBuf_Skip(&p->cb, span_len);
+			continue;
+		}
+
+		break;
+	}
+
+	p->peek_len = rec_len;
+	*len = rec_len;
+
+	return &span[CIRC_BUF_REC_HDR_LEN];
+}
+
+
+// удалить запись, выданную CircBufRec_Peek
+circ_buf_error_code_t CircBufRec_Release(circ_buf_rec_t *p)
+{
+	if(p == NULL)
+		return CIRC_BUF__NULL_POINTER;
+
+	CircBuf_Skip(&p->cb, p->peek_len + CIRC_BUF_REC_HDR_LEN);
+	p->peek_len = 0;
+
+	return CIRC_BUF__OK;
+}
+
+
+// записать запись с копированием
+circ_buf_error_code_t CircBufRec_Write(circ_buf_rec_t *p, uint8_t *data, uint16_t len)
+{
+	uint8_t *dst;
+
+	if((p == NULL) || (data == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	dst = CircBufRec_Reserve(p, len);
+	if(dst == NULL)
+		return CIRC_BUF__OVF;
+
+	memcpy(dst, data, len);
+
+	return CircBufRec_Commit(p, len);
+}
+
+
+// прочитать запись с копированием, запись длиннее max_len не удаляется
+circ_buf_error_code_t CircBufRec_Read(circ_buf_rec_t *p, uint8_t *dst, uint16_t max_len, uint16_t *len)
+{
+	uint8_t *src;
+
+	if((p == NULL) || (dst == NULL) || (len == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	src = CircBufRec_Peek(p, len);
+	if(src == NULL)
+		return CIRC_BUF__EMPTY;
+
+	if(*len > max_len)
+		return CIRC_BUF__OVF;
+
+	memcpy(dst, src, *len);
+
+	return CircBufRec_Release(p);
+}
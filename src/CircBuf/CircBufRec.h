@@ -0,0 +1,72 @@
+/**************************************************************************//**
+ * @file      CircBufRec.h
+ * @brief     Length-prefixed record ring based on circular buffer. Header file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef APPLICATION_SUPPORTLIBS_CIRCBUFREC_H_
+#define APPLICATION_SUPPORTLIBS_CIRCBUFREC_H_
+
+
+#include "CircBuf.h"
+
+
+#define CIRC_BUF_REC_HDR_LEN   2           // размер заголовка записи (длина данных)
+#define CIRC_BUF_REC_PAD       0xFFFF      // отметка заполнителя до границы буфера
+
+
+// кольцевой буфер записей переменной длины
+// запись (заголовок + данные) всегда лежит в буфере непрерывно, если до границы буфера
+// места не хватает, остаток заполняется заполнителем и запись начинается с начала буфера
+typedef struct
+{
+	circ_buf_t cb;                         // кольцевой буфер
+
+	uint16_t resv_len;                     // размер зарезервированной писателем записи
+	uint8_t  reserved;                     // 1 - запись зарезервирована и ещё не зафиксирована
+	uint16_t peek_len;                     // размер записи, выданной читателю
+
+} circ_buf_rec_t;
+
+
+// инициализация (режимы CIRC_BUF_MODE_DMA и CIRC_BUF_MODE_OVERWRITE не поддерживаются)
+circ_buf_error_code_t CircBufRec_Init(circ_buf_rec_t *p, circ_buf_init_t *init);
+
+// зарезервировать место под запись длиной len, возвращает указатель на данные записи или NULL
+uint8_t* CircBufRec_Reserve(circ_buf_rec_t *p, uint16_t len);
+
+// зафиксировать зарезервированную запись, len - фактическая длина (не больше зарезервированной)
+// без предшествующего CircBufRec_Reserve возвращает CIRC_BUF__WRONG_ARG
+circ_buf_error_code_t CircBufRec_Commit(circ_buf_rec_t *p, uint16_t len);
+
+// получить указатель на данные самой старой записи без копирования или NULL, если записей нет
+uint8_t* CircBufRec_Peek(circ_buf_rec_t *p, uint16_t *len);
+
+// удалить запись, выданную CircBufRec_Peek
+circ_buf_error_code_t CircBufRec_Release(circ_buf_rec_t *p);
+
+// записать запись с копированием
+circ_buf_error_code_t CircBufRec_Write(circ_buf_rec_t *p, uint8_t *data, uint16_t len);
+
+// прочитать запись с копированием, запись длиннее max_len не удаляется
+circ_buf_error_code_t CircBufRec_Read(circ_buf_rec_t *p, uint8_t *dst, uint16_t max_len, uint16_t *len);
+
+
+
+#endif /* APPLICATION_SUPPORTLIBS_CIRCBUFREC_H_ */
@@ -0,0 +1,194 @@
+/**************************************************************************//**
+ * @file      CircBufSpsc.c
+ * @brief     Single-producer single-consumer circular buffer with cache-line separated state. Source file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "CircBufSpsc.h"
+
+
+// число данных по копии конечного индекса, копия обновляется, если данных меньше need (читатель)
+static uint32_t Private_CircBufSpsc_GetDataLen(circ_buf_spsc_t *p, uint32_t need);
+
+
+// инициализация, длина буфера - степень двойки
+circ_buf_error_code_t CircBufSpsc_Init(circ_buf_spsc_t *p, uint8_t *buf_ptr, uint32_t buf_len)
+{
+	if((p == NULL) || (buf_ptr == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	if((buf_len == 0) || (buf_len & (buf_len - 1)) || (buf_len > 0x80000000))
+		return CIRC_BUF__WRONG_ARG;
+
+	memset(p, 0, sizeof(circ_buf_spsc_t));
+
+	p->buf_ptr  = buf_ptr;
+	p->buf_len  = buf_len;
+	p->ind_mask = buf_len - 1;
+
+	return CIRC_BUF__OK;
+}
+
+
+// получить свободное место (писатель)
+uint32_t CircBufSpsc_GetFreeLen(circ_buf_spsc_t *p)
+{
+	if(p == NULL)
+		return 0;
+
+	p->start_cache = p->start_ind;
+	MEM_BARRIER();                                                              // запись после чтения индекса
+
+	return p->buf_len - (p->end_ind - p->start_cache);
+}
+
+
+// добавить данные (писатель)
+circ_buf_error_code_t CircBufSpsc_AddData(circ_buf_spsc_t *p, uint8_t *data, uint32_t len)
+{
+	uint32_t end_ind;
+	uint32_t pos;
+	uint32_t len_to_border;
+
+	if((p == NULL) || (data == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	if(len == 0)
+		return CIRC_BUF__WRONG_ARG;
+
+	end_ind = p->end_ind;
+
+	// по копии места не хватает - обновляем её из строки читателя
+	if(len > p->buf_len - (end_ind - p->start_cache))
+	{
+		p->start_cache = p->start_ind;
+		MEM_BARRIER();                                                          // запись после чтения индекса
+
+		// проверка на переполение буфера
+		if(len > p->buf_len - (end_ind - p->start_cache))
+		{
+			p->ovf_err_cnt++;
+			p->lost_bytes += len;
+
+			return CIRC_BUF__OVF;
+		}
+	}
+
+	pos = end_ind & p->ind_mask;                                                // позиция записи в буфере
+	len_to_border = p->buf_len - pos;                                           // расстояние до границы буфера
+
+	// если данные не пересекают границу
+	if(len <= len_to_border)
+	{
+		memcpy(&p->buf_ptr[pos], data, len);                                    // копируем данные
+	}else                                                                       // если данные пересекают границу
+	{
+		memcpy(&p->buf_ptr[pos], data, len_to_border);                          // копируем до границы
+		memcpy(&p->buf_ptr[0], &data[len_to_border], len - len_to_border);      // копируем оставшиеся данные
+	}
+
+	MEM_BARRIER();                                                              // данные записаны до публикации
+	p->end_ind = end_ind + len;
+
+	return CIRC_BUF__OK;
+}
+
+
+// получить число данных (читатель)
+uint32_t CircBufSpsc_GetDataLen(circ_buf_spsc_t *p)
+{
+	if(p == NULL)
+		return 0;
+
+	return Private_CircBufSpsc_GetDataLen(p, 1);
+}
+
+
+// прочитать данные (не более max_len), возвращает число прочитанных байт (читатель)
+uint32_t CircBufSpsc_ReadData(circ_buf_spsc_t *p, uint8_t *dst, uint32_t max_len)
+{
+	uint32_t len;
+	uint32_t pos;
+	uint32_t len_to_border;
+
+	if((p == NULL) || (dst == NULL))
+		return 0;
+
+	len = Private_CircBufSpsc_GetDataLen(p, max_len);
+	if(len > max_len)
+		len = max_len;
+
+	if(len == 0)
+		return 0;
+
+	pos = p->start_ind & p->ind_mask;                                           // позиция чтения в буфере
+	len_to_border = p->buf_len - pos;                                           // расстояние до границы буфера
+
+	// если данные не пересекают границу
+	if(len <= len_to_border)
+	{
+		memcpy(dst, &p->buf_ptr[pos], len);                                     // копируем данные
+	}else                                                                       // если данные пересекают границу
+	{
+		memcpy(dst, &p->buf_ptr[pos], len_to_border);                           // копируем до границы
+		memcpy(&dst[len_to_border], &p->buf_ptr[0], len - len_to_border);       // копируем оставшиеся данные
+	}
+
+	MEM_BARRIER();                                                              // данные прочитаны до освобождения места
+	p->start_ind += len;
+
+	return len;
+}
+
+
+// удалить данные (не более len), возвращает число удалённых байт (читатель)
+uint32_t CircBufSpsc_Skip(circ_buf_spsc_t *p, uint32_t len)
+{
+	uint32_t data_len;
+
+	if(p == NULL)
+		return 0;
+
+	data_len = Private_CircBufSpsc_GetDataLen(p, len);
+	if(len > data_len)
+		len = data_len;
+
+	MEM_BARRIER();
+	p->start_ind += len;
+
+	return len;
+}
+
+
+// число данных по копии конечного индекса, копия обновляется, если данных меньше need (читатель)
+static uint32_t Private_CircBufSpsc_GetDataLen(circ_buf_spsc_t *p, uint32_t need)
+{
+	uint32_t len = p->end_cache - p->start_ind;
+
+	if(len < need)
+	{
+		p->end_cache = p->end_ind;
+		MEM_BARRIER();                                                          // данные читаются после индекса
+
+		len = p->end_cache - p->start_ind;
+	}
+
+	return len;
+}
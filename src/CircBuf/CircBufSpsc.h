@@ -0,0 +1,82 @@
+/**************************************************************************//**
+ * @file      CircBufSpsc.h
+ * @brief     Single-producer single-consumer circular buffer with cache-line separated state. Header file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef APPLICATION_SUPPORTLIBS_CIRCBUFSPSC_H_
+#define APPLICATION_SUPPORTLIBS_CIRCBUFSPSC_H_
+
+
+#include "CircBuf.h"                    // коды ошибок
+
+
+#ifndef CIRC_BUF_CACHE_LINE
+#define CIRC_BUF_CACHE_LINE     64      // размер строки кэша, байт
+#endif
+
+
+// кольцевой буфер для одного писателя и одного читателя на разных ядрах
+// поля писателя и читателя разделены полной строкой кэша, чтобы запись одной стороны не вытесняла
+// строку другой; каждая сторона хранит копию индекса другой стороны и обновляет её,
+// только когда по копии буфер выглядит полным (писатель) или пустым (читатель)
+typedef struct
+{
+	uint8_t* buf_ptr;                      // указатель на буфер
+	uint32_t buf_len;                      // длина буфера (степень двойки)
+	uint32_t ind_mask;                     // маска позиции в буфере
+
+	uint8_t pad0[CIRC_BUF_CACHE_LINE];     // разделение строк кэша
+
+	volatile uint32_t end_ind;             // конечный индекс данных, свободно бегущий (писатель)
+	uint32_t start_cache;                  // копия начального индекса (писатель)
+	uint32_t ovf_err_cnt;                  // счётчик переполнения буфера (писатель)
+	uint32_t lost_bytes;                   // потеряно байт (писатель)
+
+	uint8_t pad1[CIRC_BUF_CACHE_LINE];     // разделение строк кэша
+
+	volatile uint32_t start_ind;           // начальный индекс данных, свободно бегущий (читатель)
+	uint32_t end_cache;                    // копия конечного индекса (читатель)
+
+	uint8_t pad2[CIRC_BUF_CACHE_LINE];     // разделение со следующими переменными
+
+} circ_buf_spsc_t;
+
+
+// инициализация, длина буфера - степень двойки
+circ_buf_error_code_t CircBufSpsc_Init(circ_buf_spsc_t *p, uint8_t *buf_ptr, uint32_t buf_len);
+
+// получить свободное место (писатель)
+uint32_t CircBufSpsc_GetFreeLen(circ_buf_spsc_t *p);
+
+// добавить данные (писатель)
+circ_buf_error_code_t CircBufSpsc_AddData(circ_buf_spsc_t *p, uint8_t *data, uint32_t len);
+
+// получить число данных (читатель)
+uint32_t CircBufSpsc_GetDataLen(circ_buf_spsc_t *p);
+
+// прочитать данные (не более max_len), возвращает число прочитанных байт (читатель)
+uint32_t CircBufSpsc_ReadData(circ_buf_spsc_t *p, uint8_t *dst, uint32_t max_len);
+
+// удалить данные (не более len), возвращает число удалённых байт (читатель)
+uint32_t CircBufSpsc_Skip(circ_buf_spsc_t *p, uint32_t len);
+
+
+
+#endif /* APPLICATION_SUPPORTLIBS_CIRCBUFSPSC_H_ */
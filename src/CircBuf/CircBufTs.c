@@ -0,0 +1,263 @@
+/**************************************************************************//**
+ * @file      CircBufTs.c
+ * @brief     Circular buffer of timestamped fixed-size samples. Source file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+
+#include "CircBufTs.h"
+#include "Platform/sl_platform.h"
+
+
+// номер первой записи с меткой не меньше ts (strict = 0) или больше ts (strict = 1), num - если таких нет
+static uint16_t Private_CircBufTs_Search(circ_buf_ts_t *p, uint16_t num, uint32_t ts, uint8_t strict);
+
+// удалить самую старую запись
+static void Private_CircBufTs_DropOldest(circ_buf_ts_t *p);
+
+
+// инициализация
+circ_buf_error_code_t CircBufTs_Init(circ_buf_ts_t *p, uint8_t *buf_ptr, uint16_t buf_len, uint16_t sample_size, uint32_t max_age_us)
+{
+	circ_buf_init_t init;
+	uint32_t rec_len;
+
+	if((p == NULL) || (buf_ptr == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	rec_len = CIRC_BUF_TS_HDR_LEN + (uint32_t)sample_size;
+
+	// одна запись резервируется, чтобы полный буфер отличался от пустого
+	if((sample_size == 0) || (buf_len / rec_len < 2))
+		return CIRC_BUF__WRONG_ARG;
+
+	memset(p, 0, sizeof(circ_buf_ts_t));
+	memset(&init, 0, sizeof(circ_buf_init_t));
+
+	init.buf_ptr = buf_ptr;
+	init.buf_len = (buf_len / rec_len) * rec_len;                               // кратно длине записи
+
+	p->rec_len    = rec_len;
+	p->rec_num    = buf_len / rec_len - 1;
+	p->max_age_us = max_age_us;
+
+	return CircBuf_Init(&p->cb, &init);
+}
+
+
+// добавить отсчёт с текущей меткой времени
+circ_buf_error_code_t CircBufTs_Add(circ_buf_ts_t *p, uint8_t *sample)
+{
+	return CircBufTs_AddTs(p, sample, SL_GetTick_us());
+}
+
+
+// добавить отсчёт с заданной меткой времени
+circ_buf_error_code_t CircBufTs_AddTs(circ_buf_ts_t *p, uint8_t *sample, uint32_t ts)
+{
+	uint16_t len;
+	uint8_t *rec;
+
+	if((p == NULL) || (sample == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	if(p->max_age_us != 0)
+		CircBufTs_Evict(p, ts);
+
+	if(CircBufTs_GetNum(p) >= p->rec_num)
+	{
+		if(p->hold)                                                             // выгружаемые записи не трогаем
+		{
+			p->cb.ovf_err_cnt++;
+			p->cb.lost_bytes += p->rec_len;
+
+			return CIRC_BUF__OVF;
+		}
+
+		Private_CircBufTs_DropOldest(p);
+	}
+
+	// записи выровнены по длине, поэтому свободный участок до границы вмещает целую запись
+	rec = CircBuf_GetWriteSpan(&p->cb, &len);
+
+	memcpy(rec, &ts, CIRC_BUF_TS_HDR_LEN);
+	memcpy(&rec[CIRC_BUF_TS_HDR_LEN], sample, p->rec_len - CIRC_BUF_TS_HDR_LEN);
+
+	return CircBuf_CommitWrite(&p->cb, p->rec_len);                             // запись публикуется целиком
+}
+
+
+// удалить записи старше max_age_us относительно now
+uint16_t CircBufTs_Evict(circ_buf_ts_t *p, uint32_t now)
+{
+	uint16_t cnt = 0;
+
+	if((p == NULL) || (p->max_age_us == 0) || p->hold)
+		return 0;
+
+	while(CircBufTs_GetNum(p) != 0)
+	{
+		if((now - CircBufTs_RecTs(CircBufTs_GetRec(p, 0))) <= p->max_age_us)
+			break;
+
+		Private_CircBufTs_DropOldest(p);
+		cnt++;
+	}
+
+	return cnt;
+}
+
+
+// приостановить или возобновить удаление старых записей
+void CircBufTs_Hold(circ_buf_ts_t *p, uint8_t hold)
+{
+	if(p == NULL)
+		return;
+
+	MEM_BARRIER();
+	p->hold = hold;
+	MEM_BARRIER();
+}
+
+
+// получить число записей
+uint16_t CircBufTs_GetNum(circ_buf_ts_t *p)
+{
+	if(p == NULL)
+		return 0;
+
+	return CircBuf_GetDataLen(&p->cb) / p->rec_len;
+}
+
+
+// получить указатель на запись с номером n
+uint8_t* CircBufTs_GetRec(circ_buf_ts_t *p, uint16_t n)
+{
+	uint32_t pos;
+
+	if(p == NULL)
+		return NULL;
+
+	pos = CircBuf_GetStartIndex(&p->cb) + (uint32_t)n * p->rec_len;
+	if(pos >= p->cb.buf_len)
+		pos -= p->cb.buf_len;
+
+	return &p->cb.buf_ptr[pos];
+}
+
+
+// найти первую запись с меткой не меньше ts
+circ_buf_error_code_t CircBufTs_Find(circ_buf_ts_t *p, uint32_t ts, uint16_t *n)
+{
+	uint16_t num;
+	uint16_t ind;
+
+	if((p == NULL) || (n == NULL))
+		return CIRC_BUF__NULL_POINTER;
+
+	num = CircBufTs_GetNum(p);
+	ind = Private_CircBufTs_Search(p, num, ts, 0);
+	if(ind >= num)
+		return CIRC_BUF__NOT_FOUND;
+
+	*n = ind;
+	return CIRC_BUF__OK;
+}
+
+
+// получить участки с записями, метки которых лежат в [ts_from, ts_to]
+uint8_t CircBufTs_GetRange(circ_buf_ts_t *p, uint32_t ts_from, uint32_t ts_to, circ_buf_seg_t *seg, uint16_t *rec_cnt)
+{
+	uint16_t num;
+	uint16_t first;
+	uint16_t last;
+
+	if(rec_cnt != NULL)
+		*rec_cnt = 0;
+
+	if((p == NULL) || (seg == NULL))
+		return 0;
+
+	num   = CircBufTs_GetNum(p);
+	first = Private_CircBufTs_Search(p, num, ts_from, 0);
+	last  = Private_CircBufTs_Search(p, num, ts_to, 1);
+
+	if(first >= last)
+		return 0;
+
+	if(rec_cnt != NULL)
+		*rec_cnt = last - first;
+
+	return CircBuf_GetSegsBetweenIndexes(&p->cb, seg,
+	                                     CircBufTs_GetRec(p, first) - p->cb.buf_ptr,
+	                                     CircBufTs_GetRec(p, last) - p->cb.buf_ptr);
+}
+
+
+// получить участки с записями за последние dur_us микросекунд
+uint8_t CircBufTs_GetLast(circ_buf_ts_t *p, uint32_t dur_us, circ_buf_seg_t *seg, uint16_t *rec_cnt)
+{
+	uint32_t now = SL_GetTick_us();
+
+	return CircBufTs_GetRange(p, now - dur_us, now, seg, rec_cnt);
+}
+
+
+// номер первой записи с меткой не меньше ts (strict = 0) или больше ts (strict = 1)
+// метки сравниваются по смещению от самой старой записи, поэтому переполнение счётчика
+// микросекунд внутри окна буфера не нарушает порядок
+static uint16_t Private_CircBufTs_Search(circ_buf_ts_t *p, uint16_t num, uint32_t ts, uint8_t strict)
+{
+	uint16_t lo = 0;
+	uint16_t hi = num;
+	uint16_t mid;
+	uint32_t base;
+	uint32_t key;
+
+	if(num == 0)
+		return 0;
+
+	base = CircBufTs_RecTs(CircBufTs_GetRec(p, 0));
+
+	if((int32_t)(ts - base) < 0)                                                // раньше самой старой записи
+		return 0;
+
+	key = ts - base;
+
+	while(lo < hi)
+	{
+		mid = lo + (hi - lo) / 2;
+
+		uint32_t val = CircBufTs_RecTs(CircBufTs_GetRec(p, mid)) - base;
+		if((val < key) || (strict && (val == key)))
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return lo;
+}
+
+
+// удалить самую старую запись
+static void Private_CircBufTs_DropOldest(circ_buf_ts_t *p)
+{
+	CircBuf_Skip(&p->cb, p->rec_len);
+	p->evict_cnt++;
+}
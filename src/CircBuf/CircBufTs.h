@@ -0,0 +1,103 @@
+/**************************************************************************//**
+ * @file      CircBufTs.h
+ * @brief     Circular buffer of timestamped fixed-size samples. Header file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef APPLICATION_SUPPORTLIBS_CIRCBUFTS_H_
+#define APPLICATION_SUPPORTLIBS_CIRCBUFTS_H_
+
+
+#include "CircBuf.h"
+
+
+#define CIRC_BUF_TS_HDR_LEN     4       // длина метки времени в начале записи
+
+
+// кольцевой буфер отсчётов фиксированной длины с метками времени SL_GetTick_us
+// запись: метка времени (4 байта) + отсчёт; длина буфера кратна длине записи, поэтому записи
+// не пересекают границу буфера, а метки времени упорядочены по возрастанию от старой записи к новой
+typedef struct
+{
+	circ_buf_t cb;                         // хранилище записей
+	uint16_t rec_len;                      // длина записи (метка + отсчёт)
+	uint16_t rec_num;                      // вместимость в записях
+
+	uint32_t max_age_us;                   // максимальный возраст записи, 0 - без ограничения
+	volatile uint8_t hold;                 // 1 - удаление старых записей приостановлено (выгрузка)
+
+	uint32_t evict_cnt;                    // удалено записей по возрасту или заполнению
+
+} circ_buf_ts_t;
+
+
+// инициализация
+// sample_size - длина отсчёта, buf_len - не меньше двух записей (используется кратная длине записи часть)
+circ_buf_error_code_t CircBufTs_Init(circ_buf_ts_t *p, uint8_t *buf_ptr, uint16_t buf_len, uint16_t sample_size, uint32_t max_age_us);
+
+// добавить отсчёт с текущей меткой времени
+circ_buf_error_code_t CircBufTs_Add(circ_buf_ts_t *p, uint8_t *sample);
+
+// добавить отсчёт с заданной меткой времени (метки должны не убывать)
+// при заполнении удаляется самая старая запись, в режиме hold возвращается CIRC_BUF__OVF
+circ_buf_error_code_t CircBufTs_AddTs(circ_buf_ts_t *p, uint8_t *sample, uint32_t ts);
+
+// удалить записи старше max_age_us относительно now, возвращает число удалённых записей
+uint16_t CircBufTs_Evict(circ_buf_ts_t *p, uint32_t now);
+
+// приостановить (hold = 1) или возобновить удаление старых записей
+// пока удаление приостановлено, участки, полученные через CircBufTs_GetRange, не перезаписываются
+void CircBufTs_Hold(circ_buf_ts_t *p, uint8_t hold);
+
+// получить число записей
+uint16_t CircBufTs_GetNum(circ_buf_ts_t *p);
+
+// получить указатель на запись с номером n (0 - самая старая)
+uint8_t* CircBufTs_GetRec(circ_buf_ts_t *p, uint16_t n);
+
+// найти первую запись с меткой не меньше ts (двоичный поиск), n - номер записи
+circ_buf_error_code_t CircBufTs_Find(circ_buf_ts_t *p, uint32_t ts, uint16_t *n);
+
+// получить участки (не более CIRC_BUF_SEG_NUM) с записями, метки которых лежат в [ts_from, ts_to]
+// возвращает число участков, rec_cnt - число записей (может быть NULL)
+uint8_t CircBufTs_GetRange(circ_buf_ts_t *p, uint32_t ts_from, uint32_t ts_to, circ_buf_seg_t *seg, uint16_t *rec_cnt);
+
+// получить участки с записями за последние dur_us микросекунд
+uint8_t CircBufTs_GetLast(circ_buf_ts_t *p, uint32_t dur_us, circ_buf_seg_t *seg, uint16_t *rec_cnt);
+
+
+// получить метку времени записи
+SFINLINE uint32_t CircBufTs_RecTs(const uint8_t *rec)
+{
+	uint32_t ts;
+
+	memcpy(&ts, rec, CIRC_BUF_TS_HDR_LEN);                                      // запись может быть не выровнена
+	return ts;
+}
+
+
+// получить указатель на отсчёт записи
+SFINLINE uint8_t* CircBufTs_RecData(uint8_t *rec)
+{
+	return &rec[CIRC_BUF_TS_HDR_LEN];
+}
+
+
+
+#endif /* APPLICATION_SUPPORTLIBS_CIRCBUFTS_H_ */
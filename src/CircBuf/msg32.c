@@ -24,11 +24,33 @@
 #include "msg32.h"
 #include <string.h>
 #include "Platform/compiler_macros.h"
+#include "Platform/sl_platform.h"
 
 
 // inc index
 static uint16_t Msg32_IncIndex(uint16_t buf_size, uint16_t ind);
 
+// wake blocked reader after write
+static void Msg32_Signal(msg32_t* p);
+
+// set ready bit of the queue and wake set reader
+static void Msg32_SetSignal(msg32_set_t* s, uint8_t id);
+
+// take next ready queue from set
+static msg32_t* Msg32_SetTake(msg32_set_t* s);
+
+// blocking read with selected read function
+static msg32_ret_t Msg32_Wait(msg32_t* p, uint32_t* data_ptr, uint32_t timeout_ms, msg32_read_fn_t read);
+
+// add value to index
+static uint16_t Msg32_AddIndex(uint16_t buf_size, uint16_t ind, uint16_t add);
+
+// inc index in SPSC mode (range 0 .. 2 * buf_size - 1)
+static uint16_t Msg32_SpscIncIndex(uint16_t buf_size, uint16_t ind);
+
+// number of elements between SPSC indices
+static uint16_t Msg32_SpscCount(uint16_t buf_size, uint16_t start_ind, uint16_t end_ind);
+
 
 // initialize
 msg32_ret_t Msg32_Initialize(msg32_t* p, uint32_t* buf_ptr, uint16_t buf_size)
@@ -60,6 +82,8 @@ msg32_ret_t Msg32_WriteData(msg32_t* p, uint32_t data)
 	p->cnt++;
 	p->end_ind = Msg32_IncIndex(p->buf_size, p->end_ind);
 
+	Msg32_Signal(p);
+
 	return MSG32__OK;
 }
 
@@ -103,6 +127,182 @@ msg32_ret_t Msg32_WriteReadProtected(msg32_t* p, uint32_t* data_ptr)
 }
 
 
+// write up to n elements with at most two copies and one state update
+msg32_ret_t Msg32_WriteBatch(msg32_t* p, const uint32_t* src, uint16_t n, uint16_t* written)
+{
+	uint16_t len;
+	uint16_t len_to_border;
+
+	if(written != NULL)
+		*written = 0;
+
+	if((p == NULL) || (src == NULL))
+		return MSG32__NULL_POINTER;
+
+	len = p->buf_size - p->cnt;                             // free space
+	if(len > n)
+		len = n;
+
+	if(len != 0)
+	{
+		len_to_border = p->buf_size - p->end_ind;
+
+		if(len <= len_to_border)
+		{
+			memcpy(&p->buf_ptr[p->end_ind], src, len * sizeof(uint32_t));
+		}else
+		{
+			memcpy(&p->buf_ptr[p->end_ind], src, len_to_border * sizeof(uint32_t));
+			memcpy(&p->buf_ptr[0], &src[len_to_border], (len - len_to_border) * sizeof(uint32_t));
+		}
+
+		p->cnt += len;
+		p->end_ind = Msg32_AddIndex(p->buf_size, p->end_ind, len);
+
+		Msg32_Signal(p);
+	}
+
+	if(written != NULL)
+		*written = len;
+
+	return (len == n) ? MSG32__OK : MSG32__OVF;
+}
+
+
+// read up to max elements with at most two copies and one state update
+msg32_ret_t Msg32_ReadBatch(msg32_t* p, uint32_t* dst, uint16_t max, uint16_t* read)
+{
+	uint16_t len;
+	uint16_t len_to_border;
+
+	if(read != NULL)
+		*read = 0;
+
+	if((p == NULL) || (dst == NULL))
+		return MSG32__NULL_POINTER;
+
+	len = p->cnt;
+	if(len > max)
+		len = max;
+
+	if(len == 0)
+		return MSG32__EMPTY;
+
+	len_to_border = p->buf_size - p->start_ind;
+
+	if(len <= len_to_border)
+	{
+		memcpy(dst, &p->buf_ptr[p->start_ind], len * sizeof(uint32_t));
+	}else
+	{
+		memcpy(dst, &p->buf_ptr[p->start_ind], len_to_border * sizeof(uint32_t));
+		memcpy(&dst[len_to_border], &p->buf_ptr[0], (len - len_to_border) * sizeof(uint32_t));
+	}
+
+	p->cnt -= len;
+	p->start_ind = Msg32_AddIndex(p->buf_size, p->start_ind, len);
+
+	if(read != NULL)
+		*read = len;
+
+	return MSG32__OK;
+}
+
+
+// batch write in thread safe mode
+msg32_ret_t Msg32_WriteBatchProtected(msg32_t* p, const uint32_t* src, uint16_t n, uint16_t* written)
+{
+	uint32_t s;
+	ENTER_CRITICAL(s);
+	msg32_ret_t ret = Msg32_WriteBatch(p, src, n, written);
+	LEAVE_CRITICAL(s);
+	return ret;
+}
+
+
+// batch read in thread safe mode
+msg32_ret_t Msg32_ReadBatchProtected(msg32_t* p, uint32_t* dst, uint16_t max, uint16_t* read)
+{
+	uint32_t s;
+	ENTER_CRITICAL(s);
+	msg32_ret_t ret = Msg32_ReadBatch(p, dst, max, read);
+	LEAVE_CRITICAL(s);
+	return ret;
+}
+
+
+// initialize for SPSC mode
+msg32_ret_t Msg32_SpscInitialize(msg32_t* p, uint32_t* buf_ptr, uint16_t buf_size)
+{
+	if(buf_size > 0x8000)
+		return MSG32__WRONG_ARG;
+
+	return Msg32_Initialize(p, buf_ptr, buf_size);
+}
+
+
+// write data (single writer)
+msg32_ret_t Msg32_SpscWriteData(msg32_t* p, uint32_t data)
+{
+	uint16_t start_ind;
+	uint16_t end_ind;
+
+	if(p == NULL)
+		return MSG32__NULL_POINTER;
+
+	end_ind   = p->end_ind;
+	start_ind = *(volatile uint16_t*)&p->start_ind;
+	MEM_BARRIER();                                          // slot is written after reader released it
+
+	if(Msg32_SpscCount(p->buf_size, start_ind, end_ind) >= p->buf_size)
+		return MSG32__OVF;
+
+	p->buf_ptr[(end_ind < p->buf_size) ? end_ind : (end_ind - p->buf_size)] = data;
+
+	MEM_BARRIER();                                          // data is written before index is published
+	*(volatile uint16_t*)&p->end_ind = Msg32_SpscIncIndex(p->buf_size, end_ind);
+
+	Msg32_Signal(p);
+
+	return MSG32__OK;
+}
+
+
+// read data (single reader)
+msg32_ret_t Msg32_SpscReadData(msg32_t* p, uint32_t* data_ptr)
+{
+	uint16_t start_ind;
+	uint16_t end_ind;
+
+	if((p == NULL) || (data_ptr == NULL))
+		return MSG32__NULL_POINTER;
+
+	start_ind = p->start_ind;
+	end_ind   = *(volatile uint16_t*)&p->end_ind;
+	MEM_BARRIER();                                          // data is read after index
+
+	if(start_ind == end_ind)
+		return MSG32__EMPTY;
+
+	*data_ptr = p->buf_ptr[(start_ind < p->buf_size) ? start_ind : (start_ind - p->buf_size)];
+
+	MEM_BARRIER();                                          // data is read before slot is released
+	*(volatile uint16_t*)&p->start_ind = Msg32_SpscIncIndex(p->buf_size, start_ind);
+
+	return MSG32__OK;
+}
+
+
+// get number of elements
+uint16_t Msg32_SpscGetCount(msg32_t* p)
+{
+	if(p == NULL)
+		return 0;
+
+	return Msg32_SpscCount(p->buf_size, *(volatile uint16_t*)&p->start_ind, *(volatile uint16_t*)&p->end_ind);
+}
+
+
 // inc index
 static uint16_t Msg32_IncIndex(uint16_t buf_size, uint16_t ind)
 {
@@ -113,7 +313,275 @@ static uint16_t Msg32_IncIndex(uint16_t buf_size, uint16_t ind)
 }
 
 
+// blocking read
+msg32_ret_t Msg32_ReadWait(msg32_t* p, uint32_t* data_ptr, uint32_t timeout_ms)
+{
+	return Msg32_Wait(p, data_ptr, timeout_ms, Msg32_WriteReadProtected);
+}
+
 
+// blocking read in SPSC mode
+msg32_ret_t Msg32_SpscReadWait(msg32_t* p, uint32_t* data_ptr, uint32_t timeout_ms)
+{
+	return Msg32_Wait(p, data_ptr, timeout_ms, Msg32_SpscReadData);
+}
+
+
+// blocking read with own read function
+msg32_ret_t Msg32_ReadWaitFn(msg32_t* p, uint32_t* data_ptr, uint32_t timeout_ms, msg32_read_fn_t read)
+{
+	if(read == NULL)
+		return MSG32__NULL_POINTER;
+
+	return Msg32_Wait(p, data_ptr, timeout_ms, read);
+}
+
+
+// wake blocked reader after write
+// the writer publishes data before it checks the flag and the reader sets the flag before it checks
+// the queue, so with barriers on both sides either the writer sees the flag or the reader sees the data
+static void Msg32_Signal(msg32_t* p)
+{
+	MEM_BARRIER();
+	if(p->set != NULL)
+		Msg32_SetSignal(p->set, p->set_id);
+
+	if(!p->waiting)
+		return;
+
+	p->wait_seq++;
+	SL_SignalEvent(&p->wait_seq);
+}
+
+
+// blocking read with selected read function
+static msg32_ret_t Msg32_Wait(msg32_t* p, uint32_t* data_ptr, uint32_t timeout_ms, msg32_read_fn_t read)
+{
+	msg32_ret_t ret;
+	uint32_t t0;
+	uint32_t elapsed;
+	uint32_t seq;
+
+	if((p == NULL) || (data_ptr == NULL))
+		return MSG32__NULL_POINTER;
+
+	ret = read(p, data_ptr);                                // fast path without wait
+	if((ret != MSG32__EMPTY) || (timeout_ms == 0))
+		return ret;
+
+	t0 = SL_GetTick();
+
+	while(1)
+	{
+		p->waiting = 1;
+		MEM_BARRIER();
+		seq = p->wait_seq;                                  // snapshot before the queue is checked
+
+		ret = read(p, data_ptr);
+		if(ret != MSG32__EMPTY)
+			break;
+
+		elapsed = SL_GetTick() - t0;
+		if((timeout_ms != MSG32_WAIT_FOREVER) && (elapsed >= timeout_ms))
+			break;
+
+		SL_WaitEvent(&p->wait_seq, seq, (timeout_ms == MSG32_WAIT_FOREVER) ? MSG32_WAIT_FOREVER : (timeout_ms - elapsed));
+	}
+
+	p->waiting = 0;
+
+	return ret;
+}
+
+
+// initialize set
+msg32_ret_t Msg32_SetInitialize(msg32_set_t* s)
+{
+	if(s == NULL)
+		return MSG32__NULL_POINTER;
+
+	memset(s, 0, sizeof(msg32_set_t));
+
+	return MSG32__OK;
+}
+
+
+// add queue to set
+msg32_ret_t Msg32_SetAdd(msg32_set_t* s, msg32_t* p, uint8_t* id)
+{
+	uint8_t i;
+	uint32_t primask;
+
+	if((s == NULL) || (p == NULL))
+		return MSG32__NULL_POINTER;
+	if(p->set != NULL)
+		return MSG32__WRONG_ARG;
+
+	for(i = 0; i < MSG32_SET_SIZE; i++)
+		if(s->queue[i] == NULL)
+			break;
+
+	if(i == MSG32_SET_SIZE)
+		return MSG32__OVF;
+
+	s->queue[i] = p;
+	p->set_id   = i;
+
+	ENTER_CRITICAL(primask);
+	p->set = s;
+	if((p->cnt != 0) || (p->start_ind != p->end_ind))       // data written before the queue was added
+		s->ready |= (1UL << i);
+	LEAVE_CRITICAL(primask);
+
+	if(id != NULL)
+		*id = i;
+
+	return MSG32__OK;
+}
+
+
+// remove queue from set
+msg32_ret_t Msg32_SetRemove(msg32_set_t* s, msg32_t* p)
+{
+	uint32_t primask;
+
+	if((s == NULL) || (p == NULL))
+		return MSG32__NULL_POINTER;
+	if(p->set != s)
+		return MSG32__WRONG_ARG;
+
+	ENTER_CRITICAL(primask);
+	p->set = NULL;
+	s->ready &= ~(1UL << p->set_id);
+	s->queue[p->set_id] = NULL;
+	LEAVE_CRITICAL(primask);
+
+	return MSG32__OK;
+}
+
+
+// get next ready queue
+msg32_ret_t Msg32_SetWait(msg32_set_t* s, msg32_t** q, uint32_t timeout_ms)
+{
+	msg32_t* p;
+	uint32_t t0;
+	uint32_t elapsed;
+	uint32_t seq;
+
+	if((s == NULL) || (q == NULL))
+		return MSG32__NULL_POINTER;
+
+	t0 = SL_GetTick();
+
+	while(1)
+	{
+		s->waiting = 1;
+		MEM_BARRIER();
+		seq = s->wait_seq;
+
+		p = Msg32_SetTake(s);
+		if(p != NULL)
+			break;
+
+		elapsed = SL_GetTick() - t0;
+		if((timeout_ms != MSG32_WAIT_FOREVER) && (elapsed >= timeout_ms))
+			break;
+
+		SL_WaitEvent(&s->wait_seq, seq, (timeout_ms == MSG32_WAIT_FOREVER) ? MSG32_WAIT_FOREVER : (timeout_ms - elapsed));
+	}
+
+	s->waiting = 0;
+
+	if(p == NULL)
+		return MSG32__EMPTY;
+
+	*q = p;
+
+	return MSG32__OK;
+}
+
+
+// set ready bit of the queue and wake set reader
+// the bit is tested first, so a busy queue costs no critical section until the reader takes it
+static void Msg32_SetSignal(msg32_set_t* s, uint8_t id)
+{
+	uint32_t bit = 1UL << id;
+	uint32_t primask;
+
+	if(s->ready & bit)
+		return;
+
+	ENTER_CRITICAL(primask);
+	s->ready |= bit;
+	LEAVE_CRITICAL(primask);
+
+	MEM_BARRIER();
+	if(!s->waiting)
+		return;
+
+	s->wait_seq++;
+	SL_SignalEvent(&s->wait_seq);
+}
+
+
+// take next ready queue from set
+static msg32_t* Msg32_SetTake(msg32_set_t* s)
+{
+	msg32_t* p = NULL;
+	uint32_t ready;
+	uint32_t hi;
+	uint8_t id;
+	uint32_t primask;
+
+	ENTER_CRITICAL(primask);
+
+	while((p == NULL) && (s->ready != 0))                   // bit of a removed queue is skipped
+	{
+		ready = s->ready;
+		hi = ready & ~((1UL << s->next) - 1);               // queues from next id, then wrap around
+		if(hi != 0)
+			ready = hi;
+
+		id = 31 - CLZ32(ready & (~ready + 1));              // lowest set bit
+		s->ready &= ~(1UL << id);
+		s->next = (id + 1) & (MSG32_SET_SIZE - 1);
+		p = s->queue[id];
+	}
+
+	LEAVE_CRITICAL(primask);
+
+	return p;
+}
+
+
+// add value to index
+static uint16_t Msg32_AddIndex(uint16_t buf_size, uint16_t ind, uint16_t add)
+{
+	uint32_t res = (uint32_t)ind + add;
+	if(res >= buf_size)
+		res -= buf_size;
+	return (uint16_t)res;
+}
+
+
+// inc index in SPSC mode (range 0 .. 2 * buf_size - 1)
+static uint16_t Msg32_SpscIncIndex(uint16_t buf_size, uint16_t ind)
+{
+	ind++;
+	if(ind >= 2 * (uint32_t)buf_size)
+		ind = 0;
+	return ind;
+}
+
+
+// number of elements between SPSC indices
+static uint16_t Msg32_SpscCount(uint16_t buf_size, uint16_t start_ind, uint16_t end_ind)
+{
+	if(end_ind >= start_ind)
+		return end_ind - start_ind;
+
+	return 2 * (uint32_t)buf_size - start_ind + end_ind;
+}
 
 
 
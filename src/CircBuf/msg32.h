@@ -26,6 +26,23 @@
 
 #include <stdint.h>
 #include <stddef.h>
+#include "Platform/compiler_macros.h"
+
+
+#ifndef MSG32_CACHE_LINE
+#define MSG32_CACHE_LINE    64          // cache line size, bytes
+#endif
+
+// 1 - read-only fields, reader index and writer fields of msg32_t are in separate cache lines,
+// so SPSC writer and reader on different cores do not invalidate each other's line on every element;
+// on by default for multicore host builds, MCU without data cache does not need it (+3 cache lines per queue)
+#ifndef MSG32_SPSC_PAD
+#ifdef HOST_COMPILER
+#define MSG32_SPSC_PAD      1
+#else
+#define MSG32_SPSC_PAD      0
+#endif
+#endif
 
 
 // перечисление кодов ошибок
@@ -40,18 +57,63 @@ typedef enum
 } msg32_ret_t;
 
 
+struct msg32_set_s;
+
+
 typedef struct
 {
 	uint32_t *buf_ptr;      // puffer pointer
 	uint16_t buf_size;      // buffer size in uint32_t elements
 
+#if MSG32_SPSC_PAD
+	uint8_t pad0[MSG32_CACHE_LINE];   // cache line separation
+#endif
+
 	uint16_t start_ind;     // index to read data
+
+#if MSG32_SPSC_PAD
+	uint8_t pad1[MSG32_CACHE_LINE];   // cache line separation
+#endif
+
 	uint16_t end_ind;       // index to write data
 	uint16_t cnt;           // counter of elements
 
+	volatile uint32_t wait_seq;   // event counter for blocking read
+	volatile uint8_t  waiting;    // reader is blocked in Msg32_ReadWait / Msg32_SpscReadWait
+
+	struct msg32_set_s *set;      // queue set the queue belongs to (NULL - none)
+	uint8_t set_id;               // bit of the queue in the set ready mask
+
+#if MSG32_SPSC_PAD
+	uint8_t pad2[MSG32_CACHE_LINE];   // separation from next variables
+#endif
+
 } msg32_t;
 
 
+#define MSG32_WAIT_FOREVER  0xFFFFFFFF   // timeout of blocking read without limit
+
+
+// read function for blocking read of queues built on msg32_t
+typedef msg32_ret_t (*msg32_read_fn_t)(msg32_t* p, uint32_t* data_ptr);
+
+#define MSG32_SET_SIZE      32           // max number of queues in a set (bits of ready mask)
+
+
+// queue set: writes into member queues set the queue bit in the ready mask,
+// so the event loop finds a queue with data without polling every queue
+typedef struct msg32_set_s
+{
+	msg32_t *queue[MSG32_SET_SIZE];  // member queues
+	volatile uint32_t ready;         // ready mask, bit = queue id
+	uint8_t next;                    // id to start the round-robin search from
+
+	volatile uint32_t wait_seq;      // event counter for Msg32_SetWait
+	volatile uint8_t  waiting;       // reader is blocked in Msg32_SetWait
+
+} msg32_set_t;
+
+
 // initialize
 msg32_ret_t Msg32_Initialize(msg32_t* p, uint32_t* buf_ptr, uint16_t buf_size);
 
@@ -67,6 +129,68 @@ msg32_ret_t Msg32_WriteDataProtected(msg32_t* p, uint32_t data);
 // read in thread safe mode
 msg32_ret_t Msg32_WriteReadProtected(msg32_t* p, uint32_t* data_ptr);
 
+// write up to n elements with at most two copies and one state update
+// written - number of written elements (can be NULL), returns MSG32__OVF if not all elements fit
+msg32_ret_t Msg32_WriteBatch(msg32_t* p, const uint32_t* src, uint16_t n, uint16_t* written);
+
+// read up to max elements with at most two copies and one state update
+// read - number of read elements (can be NULL), returns MSG32__EMPTY if nothing was read
+msg32_ret_t Msg32_ReadBatch(msg32_t* p, uint32_t* dst, uint16_t max, uint16_t* read);
+
+// batch write in thread safe mode (single critical section)
+msg32_ret_t Msg32_WriteBatchProtected(msg32_t* p, const uint32_t* src, uint16_t n, uint16_t* written);
+
+// batch read in thread safe mode (single critical section)
+msg32_ret_t Msg32_ReadBatchProtected(msg32_t* p, uint32_t* dst, uint16_t max, uint16_t* read);
+
+
+// lock-free single-producer single-consumer mode (Msg32_Spsc... functions only)
+// writer owns end_ind, reader owns start_ind, cnt is not used; indices run over 2 * buf_size,
+// so the fill level is derived from the two indices and the whole buffer can be used;
+// with MSG32_SPSC_PAD the two indices are in separate cache lines
+
+// initialize for SPSC mode, buf_size up to 32768
+msg32_ret_t Msg32_SpscInitialize(msg32_t* p, uint32_t* buf_ptr, uint16_t buf_size);
+
+// write data (single writer, e.g. ISR), does not disable interrupts
+msg32_ret_t Msg32_SpscWriteData(msg32_t* p, uint32_t data);
+
+// read data (single reader, e.g. task), does not disable interrupts
+msg32_ret_t Msg32_SpscReadData(msg32_t* p, uint32_t* data_ptr);
+
+// get number of elements
+uint16_t Msg32_SpscGetCount(msg32_t* p);
+
+
+// blocking read: wait for data up to timeout_ms (0 - no wait, MSG32_WAIT_FOREVER - no limit)
+// the reader is parked by SL_WaitEvent and woken by SL_SignalEvent from the write functions;
+// returns MSG32__EMPTY on timeout
+msg32_ret_t Msg32_ReadWait(msg32_t* p, uint32_t* data_ptr, uint32_t timeout_ms);
+
+// blocking read in SPSC mode
+msg32_ret_t Msg32_SpscReadWait(msg32_t* p, uint32_t* data_ptr, uint32_t timeout_ms);
+
+// blocking read with own read function (queues that keep extra state next to msg32_t, e.g. msg32_coal)
+msg32_ret_t Msg32_ReadWaitFn(msg32_t* p, uint32_t* data_ptr, uint32_t timeout_ms, msg32_read_fn_t read);
+
+
+// queue set, one reader (event loop) per set
+// the ready bit is cleared when Msg32_SetWait returns the queue, so the reader must read the queue
+// until MSG32__EMPTY; data written after that sets the bit again
+
+// initialize set
+msg32_ret_t Msg32_SetInitialize(msg32_set_t* s);
+
+// add initialized queue to set, id - bit of the queue in the ready mask (can be NULL)
+msg32_ret_t Msg32_SetAdd(msg32_set_t* s, msg32_t* p, uint8_t* id);
+
+// remove queue from set
+msg32_ret_t Msg32_SetRemove(msg32_set_t* s, msg32_t* p);
+
+// get next ready queue in round-robin order, wait up to timeout_ms (0 - no wait, MSG32_WAIT_FOREVER - no limit)
+// returns MSG32__EMPTY on timeout
+msg32_ret_t Msg32_SetWait(msg32_set_t* s, msg32_t** q, uint32_t timeout_ms);
+
 
 
 #endif /* CIRCBUF_MSG32_H_ */
@@ -0,0 +1,152 @@
+/**************************************************************************//**
+ * @file      msg32_coal.c
+ * @brief     Coalescing event queue built on msg32. Source file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "msg32_coal.h"
+#include <string.h>
+#include "Platform/compiler_macros.h"
+
+
+// word and bit of code in pending bitmap
+#define MSG32_COAL_WORD(code)   ((code) >> 5)
+#define MSG32_COAL_BIT(code)    (1UL << ((code) & 31))
+
+
+// read function for Msg32_ReadWaitFn
+static msg32_ret_t Msg32Coal_ReadMsg(msg32_t* msg, uint32_t* code_ptr);
+
+
+// initialize
+msg32_ret_t Msg32Coal_Initialize(msg32_coal_t* p, uint32_t* buf_ptr, uint32_t* pend, uint16_t code_num)
+{
+	msg32_ret_t ret;
+
+	if((p == NULL) || (pend == NULL))
+		return MSG32__NULL_POINTER;
+
+	memset(p, 0, sizeof(msg32_coal_t));
+
+	ret = Msg32_Initialize(&p->msg, buf_ptr, code_num);
+	if(ret != MSG32__OK)
+		return ret;
+
+	memset(pend, 0, MSG32_COAL_PEND_SIZE(code_num) * sizeof(uint32_t));
+
+	p->pend     = pend;
+	p->code_num = code_num;
+
+	return MSG32__OK;
+}
+
+
+// post event code
+msg32_ret_t Msg32Coal_WriteData(msg32_coal_t* p, uint32_t code)
+{
+	if(p == NULL)
+		return MSG32__NULL_POINTER;
+	if(code >= p->code_num)
+		return MSG32__WRONG_ARG;
+
+	if(p->pend[MSG32_COAL_WORD(code)] & MSG32_COAL_BIT(code))
+	{
+		p->coal_cnt++;
+		return MSG32__OK;
+	}
+
+	p->pend[MSG32_COAL_WORD(code)] |= MSG32_COAL_BIT(code);
+
+	return Msg32_WriteData(&p->msg, code);                  // can not overflow: one element per pending code
+}
+
+
+// read the oldest pending code
+msg32_ret_t Msg32Coal_ReadData(msg32_coal_t* p, uint32_t* code_ptr)
+{
+	msg32_ret_t ret;
+
+	if((p == NULL) || (code_ptr == NULL))
+		return MSG32__NULL_POINTER;
+
+	ret = Msg32_ReadData(&p->msg, code_ptr);
+	if(ret == MSG32__OK)
+		p->pend[MSG32_COAL_WORD(*code_ptr)] &= ~MSG32_COAL_BIT(*code_ptr);
+
+	return ret;
+}
+
+
+// write in thread safe mode
+msg32_ret_t Msg32Coal_WriteDataProtected(msg32_coal_t* p, uint32_t code)
+{
+	uint32_t s;
+	ENTER_CRITICAL(s);
+	msg32_ret_t ret = Msg32Coal_WriteData(p, code);
+	LEAVE_CRITICAL(s);
+	return ret;
+}
+
+
+// read in thread safe mode
+msg32_ret_t Msg32Coal_ReadDataProtected(msg32_coal_t* p, uint32_t* code_ptr)
+{
+	uint32_t s;
+	ENTER_CRITICAL(s);
+	msg32_ret_t ret = Msg32Coal_ReadData(p, code_ptr);
+	LEAVE_CRITICAL(s);
+	return ret;
+}
+
+
+// blocking read in thread safe mode
+msg32_ret_t Msg32Coal_ReadWait(msg32_coal_t* p, uint32_t* code_ptr, uint32_t timeout_ms)
+{
+	if(p == NULL)
+		return MSG32__NULL_POINTER;
+
+	return Msg32_ReadWaitFn(&p->msg, code_ptr, timeout_ms, Msg32Coal_ReadMsg);
+}
+
+
+// check if code is pending
+uint8_t Msg32Coal_IsPending(msg32_coal_t* p, uint32_t code)
+{
+	if((p == NULL) || (code >= p->code_num))
+		return 0;
+
+	return (p->pend[MSG32_COAL_WORD(code)] & MSG32_COAL_BIT(code)) ? 1 : 0;
+}
+
+
+// get number of pending codes
+uint16_t Msg32Coal_GetCount(msg32_coal_t* p)
+{
+	if(p == NULL)
+		return 0;
+
+	return p->msg.cnt;
+}
+
+
+// read function for Msg32_ReadWaitFn
+static msg32_ret_t Msg32Coal_ReadMsg(msg32_t* msg, uint32_t* code_ptr)
+{
+	return Msg32Coal_ReadDataProtected(Msg32Coal_FromMsg(msg), code_ptr);
+}
@@ -0,0 +1,82 @@
+/**************************************************************************//**
+ * @file      msg32_coal.h
+ * @brief     Coalescing event queue built on msg32. Header file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef CIRCBUF_MSG32_COAL_H_
+#define CIRCBUF_MSG32_COAL_H_
+
+
+#include "msg32.h"
+
+
+// size of pending bitmap in uint32_t words for code_num event codes
+#define MSG32_COAL_PEND_SIZE(code_num)   (((code_num) + 31) / 32)
+
+
+// coalescing queue: event codes 0 .. code_num - 1, a code that is already pending is not queued again,
+// so the queue holds at most code_num elements and can not overflow; codes are read in order of first posting
+// msg must be read only through Msg32Coal_ReadData / Msg32Coal_ReadWait: a direct Msg32 read leaves the
+// pending bit set and the code is then dropped on every later post; msg can be added to a queue set
+// (Msg32_SetAdd), the returned queue is converted back by Msg32Coal_FromMsg
+typedef struct
+{
+	msg32_t   msg;          // queue of pending codes, buffer of code_num elements (first member)
+	uint32_t *pend;         // pending bitmap, MSG32_COAL_PEND_SIZE(code_num) words
+	uint16_t  code_num;     // number of event codes
+
+	uint32_t  coal_cnt;     // counter of coalesced (suppressed) posts
+
+} msg32_coal_t;
+
+
+// initialize, buf_ptr - code_num elements, pend - MSG32_COAL_PEND_SIZE(code_num) elements
+msg32_ret_t Msg32Coal_Initialize(msg32_coal_t* p, uint32_t* buf_ptr, uint32_t* pend, uint16_t code_num);
+
+// post event code, does nothing if the code is already pending
+msg32_ret_t Msg32Coal_WriteData(msg32_coal_t* p, uint32_t code);
+
+// read the oldest pending code, the code can be posted again after read
+msg32_ret_t Msg32Coal_ReadData(msg32_coal_t* p, uint32_t* code_ptr);
+
+// write in thread safe mode
+msg32_ret_t Msg32Coal_WriteDataProtected(msg32_coal_t* p, uint32_t code);
+
+// read in thread safe mode
+msg32_ret_t Msg32Coal_ReadDataProtected(msg32_coal_t* p, uint32_t* code_ptr);
+
+// blocking read in thread safe mode, timeout_ms as in Msg32_ReadWait
+msg32_ret_t Msg32Coal_ReadWait(msg32_coal_t* p, uint32_t* code_ptr, uint32_t timeout_ms);
+
+// coalescing queue by its inner msg32_t (e.g. returned by Msg32_SetWait)
+SFINLINE msg32_coal_t* Msg32Coal_FromMsg(msg32_t* msg)
+{
+	return (msg32_coal_t*)msg;                        // msg is the first member
+}
+
+// check if code is pending
+uint8_t Msg32Coal_IsPending(msg32_coal_t* p, uint32_t code);
+
+// get number of pending codes
+uint16_t Msg32Coal_GetCount(msg32_coal_t* p);
+
+
+
+#endif /* CIRCBUF_MSG32_COAL_H_ */
@@ -0,0 +1,137 @@
+/**************************************************************************//**
+ * @file      msg32_mpmc.c
+ * @brief     Lock-free bounded MPMC queue of 32-bit messages. Source file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "msg32_mpmc.h"
+#include <string.h>
+#include "Platform/compiler_macros.h"
+
+
+// initialize
+msg32_ret_t Msg32Mpmc_Initialize(msg32_mpmc_t* p, msg32_mpmc_cell_t* cell_ptr, uint32_t buf_size)
+{
+	if((p == NULL) || (cell_ptr == NULL))
+		return MSG32__NULL_POINTER;
+	if((buf_size < 2) || (buf_size & (buf_size - 1)))
+		return MSG32__WRONG_ARG;
+
+	memset(p, 0, sizeof(msg32_mpmc_t));
+
+	for(uint32_t i = 0; i < buf_size; i++)
+		cell_ptr[i].seq = i;
+
+	p->cell = cell_ptr;
+	p->mask = buf_size - 1;
+
+	MEM_BARRIER();
+
+	return MSG32__OK;
+}
+
+
+// write data
+msg32_ret_t Msg32Mpmc_WriteData(msg32_mpmc_t* p, uint32_t data)
+{
+	msg32_mpmc_cell_t* cell;
+	uint32_t ind;
+	int32_t dif;
+
+	if(p == NULL)
+		return MSG32__NULL_POINTER;
+
+	ind = p->end_ind;
+
+	while(1)
+	{
+		cell = &p->cell[ind & p->mask];
+		dif = (int32_t)(cell->seq - ind);
+
+		if(dif == 0)
+		{
+			if(ATOMIC_CAS32(&p->end_ind, ind, ind + 1))     // cell is owned by this writer
+				break;
+		}else if(dif < 0)
+		{
+			return MSG32__OVF;                              // cell is not read yet: queue is full
+		}
+
+		ind = p->end_ind;                                   // another writer took the index
+	}
+
+	cell->data = data;
+	MEM_BARRIER();                                          // data before seq
+	cell->seq = ind + 1;
+
+	return MSG32__OK;
+}
+
+
+// read data
+msg32_ret_t Msg32Mpmc_ReadData(msg32_mpmc_t* p, uint32_t* data_ptr)
+{
+	msg32_mpmc_cell_t* cell;
+	uint32_t ind;
+	int32_t dif;
+
+	if((p == NULL) || (data_ptr == NULL))
+		return MSG32__NULL_POINTER;
+
+	ind = p->start_ind;
+
+	while(1)
+	{
+		cell = &p->cell[ind & p->mask];
+		dif = (int32_t)(cell->seq - (ind + 1));
+
+		if(dif == 0)
+		{
+			if(ATOMIC_CAS32(&p->start_ind, ind, ind + 1))   // cell is owned by this reader
+				break;
+		}else if(dif < 0)
+		{
+			return MSG32__EMPTY;                            // cell is not written yet: queue is empty
+		}
+
+		ind = p->start_ind;                                 // another reader took the index
+	}
+
+	*data_ptr = cell->data;                                 // CAS is a barrier: seq before data
+	MEM_BARRIER();                                          // data before seq
+	cell->seq = ind + p->mask + 1;                          // free for writer of the next lap
+
+	return MSG32__OK;
+}
+
+
+// get number of elements
+uint32_t Msg32Mpmc_GetCount(msg32_mpmc_t* p)
+{
+	uint32_t cnt;
+
+	if(p == NULL)
+		return 0;
+
+	cnt = p->end_ind - p->start_ind;
+	if(cnt > p->mask + 1)                                   // indices read at different moments
+		cnt = 0;
+
+	return cnt;
+}
@@ -0,0 +1,74 @@
+/**************************************************************************//**
+ * @file      msg32_mpmc.h
+ * @brief     Lock-free bounded MPMC queue of 32-bit messages. Header file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef CIRCBUF_MSG32_MPMC_H_
+#define CIRCBUF_MSG32_MPMC_H_
+
+
+#include "msg32.h"
+
+
+// queue cell, seq tells the cell state for the index that maps to it:
+// seq == ind - free for writer of ind, seq == ind + 1 - holds data for reader of ind
+typedef struct
+{
+	volatile uint32_t seq;  // cell sequence number
+	uint32_t data;          // message
+
+} msg32_mpmc_cell_t;
+
+
+// bounded queue for any number of writers and readers without critical sections (sequence-numbered cells);
+// writers and readers claim indices by CAS and then own the cell, indices run freely over uint32_t
+typedef struct
+{
+	msg32_mpmc_cell_t *cell;            // array of cells
+	uint32_t mask;                      // buf_size - 1, buf_size is power of two
+
+	uint8_t pad0[MSG32_CACHE_LINE];     // cache line separation
+
+	volatile uint32_t end_ind;          // index to write data (writers)
+
+	uint8_t pad1[MSG32_CACHE_LINE];     // cache line separation
+
+	volatile uint32_t start_ind;        // index to read data (readers)
+
+	uint8_t pad2[MSG32_CACHE_LINE];     // separation from next variables
+
+} msg32_mpmc_t;
+
+
+// initialize, cell_ptr - array of buf_size cells, buf_size - power of two from 2
+msg32_ret_t Msg32Mpmc_Initialize(msg32_mpmc_t* p, msg32_mpmc_cell_t* cell_ptr, uint32_t buf_size);
+
+// write data, any number of writers
+msg32_ret_t Msg32Mpmc_WriteData(msg32_mpmc_t* p, uint32_t data);
+
+// read data, any number of readers
+msg32_ret_t Msg32Mpmc_ReadData(msg32_mpmc_t* p, uint32_t* data_ptr);
+
+// get number of elements (estimate while writers or readers are active)
+uint32_t Msg32Mpmc_GetCount(msg32_mpmc_t* p);
+
+
+
+#endif /* CIRCBUF_MSG32_MPMC_H_ */
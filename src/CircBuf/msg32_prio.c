@@ -0,0 +1,176 @@
+/**************************************************************************//**
+ * @file      msg32_prio.c
+ * @brief     Priority message queue built on msg32 levels. Source file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#include "msg32_prio.h"
+#include <string.h>
+#include "Platform/compiler_macros.h"
+
+
+// ready mask bit of level
+#define MSG32_PRIO_BIT(level)   (0x80000000UL >> (level))
+
+
+// initialize
+msg32_ret_t Msg32Prio_Initialize(msg32_prio_t* p, msg32_prio_level_t* levels, uint8_t level_num, uint16_t starve_limit)
+{
+	if((p == NULL) || (levels == NULL))
+		return MSG32__NULL_POINTER;
+	if((level_num == 0) || (level_num > MSG32_PRIO_LEVEL_MAX))
+		return MSG32__WRONG_ARG;
+
+	memset(p, 0, sizeof(msg32_prio_t));
+	memset(levels, 0, level_num * sizeof(msg32_prio_level_t));
+
+	p->level        = levels;
+	p->level_num    = level_num;
+	p->starve_limit = starve_limit;
+
+	return MSG32__OK;
+}
+
+
+// initialize level buffer
+msg32_ret_t Msg32Prio_InitializeLevel(msg32_prio_t* p, uint8_t level, uint32_t* buf_ptr, uint16_t buf_size)
+{
+	if(p == NULL)
+		return MSG32__NULL_POINTER;
+	if(level >= p->level_num)
+		return MSG32__WRONG_ARG;
+
+	return Msg32_Initialize(&p->level[level].msg, buf_ptr, buf_size);
+}
+
+
+// write data to level
+msg32_ret_t Msg32Prio_WriteData(msg32_prio_t* p, uint8_t level, uint32_t data)
+{
+	msg32_ret_t ret;
+
+	if(p == NULL)
+		return MSG32__NULL_POINTER;
+	if(level >= p->level_num)
+		return MSG32__WRONG_ARG;
+
+	ret = Msg32_WriteData(&p->level[level].msg, data);
+	if(ret == MSG32__OVF)
+	{
+		p->level[level].ovf_cnt++;
+		return ret;
+	}
+
+	if(ret == MSG32__OK)
+		p->ready |= MSG32_PRIO_BIT(level);
+
+	return ret;
+}
+
+
+// read data from the highest non-empty level
+msg32_ret_t Msg32Prio_ReadData(msg32_prio_t* p, uint32_t* data_ptr, uint8_t* level_ptr)
+{
+	uint32_t ready;
+	uint32_t lower;
+	uint32_t cand;
+	uint8_t  level;
+	msg32_ret_t ret;
+
+	if((p == NULL) || (data_ptr == NULL))
+		return MSG32__NULL_POINTER;
+
+	ready = p->ready;
+	if(ready == 0)
+		return MSG32__EMPTY;
+
+	level = CLZ32(ready);                                   // highest non-empty level
+
+	// starvation guard: lower levels wait while higher ones are served
+	if(p->starve_limit != 0)
+	{
+		lower = ready & (MSG32_PRIO_BIT(level) - 1);            // waiting levels below the top one
+		if(lower)
+		{
+			if(++p->starve_run > p->starve_limit)
+			{
+				// next waiting lower level from the cursor, wrap around to the first waiting one,
+				// so with steady load on several levels every waiting level gets its turn
+				cand = (p->starve_next < MSG32_PRIO_LEVEL_MAX) ? (lower & (0xFFFFFFFFUL >> p->starve_next)) : 0;
+				if(cand == 0)
+					cand = lower;
+
+				level = CLZ32(cand);
+				p->starve_next = level + 1;
+				p->level[level].starve_cnt++;
+				p->starve_run = 0;
+			}
+		}else
+		{
+			p->starve_run = 0;
+		}
+	}
+
+	ret = Msg32_ReadData(&p->level[level].msg, data_ptr);
+
+	if(p->level[level].msg.cnt == 0)
+		p->ready &= ~MSG32_PRIO_BIT(level);
+
+	if((ret == MSG32__OK) && (level_ptr != NULL))
+		*level_ptr = level;
+
+	return ret;
+}
+
+
+// write in thread safe mode
+msg32_ret_t Msg32Prio_WriteDataProtected(msg32_prio_t* p, uint8_t level, uint32_t data)
+{
+	uint32_t s;
+	ENTER_CRITICAL(s);
+	msg32_ret_t ret = Msg32Prio_WriteData(p, level, data);
+	LEAVE_CRITICAL(s);
+	return ret;
+}
+
+
+// read in thread safe mode
+msg32_ret_t Msg32Prio_ReadDataProtected(msg32_prio_t* p, uint32_t* data_ptr, uint8_t* level_ptr)
+{
+	uint32_t s;
+	ENTER_CRITICAL(s);
+	msg32_ret_t ret = Msg32Prio_ReadData(p, data_ptr, level_ptr);
+	LEAVE_CRITICAL(s);
+	return ret;
+}
+
+
+// get number of elements in all levels
+uint32_t Msg32Prio_GetCount(msg32_prio_t* p)
+{
+	uint32_t cnt = 0;
+
+	if(p == NULL)
+		return 0;
+
+	for(uint8_t i = 0; i < p->level_num; i++)
+		cnt += p->level[i].msg.cnt;
+
+	return cnt;
+}
@@ -0,0 +1,83 @@
+/**************************************************************************//**
+ * @file      msg32_prio.h
+ * @brief     Priority message queue built on msg32 levels. Header file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef CIRCBUF_MSG32_PRIO_H_
+#define CIRCBUF_MSG32_PRIO_H_
+
+
+#include "msg32.h"
+
+
+#define MSG32_PRIO_LEVEL_MAX   32       // max number of levels (bits of ready mask)
+
+
+// priority level
+typedef struct
+{
+	msg32_t  msg;           // level queue
+	uint32_t ovf_cnt;       // counter of rejected writes
+	uint32_t starve_cnt;    // counter of reads forced by starvation guard
+
+} msg32_prio_level_t;
+
+
+// priority queue: level 0 has the highest priority
+typedef struct
+{
+	msg32_prio_level_t *level;      // array of levels
+	uint8_t  level_num;             // number of levels
+
+	volatile uint32_t ready;        // ready mask, bit (31 - level) is set while level is not empty
+
+	uint16_t starve_limit;          // 0 - guard off, otherwise max reads of higher levels in a row
+	                                // while lower levels wait; then one waiting lower level is served,
+	                                // waiting lower levels take turns (round robin from starve_next)
+	uint16_t starve_run;            // reads of higher levels in a row
+	uint8_t  starve_next;           // first level to check on the next forced read
+
+} msg32_prio_t;
+
+
+// initialize, levels - array of level_num elements, starve_limit - 0 disables starvation guard
+msg32_ret_t Msg32Prio_Initialize(msg32_prio_t* p, msg32_prio_level_t* levels, uint8_t level_num, uint16_t starve_limit);
+
+// initialize level buffer
+msg32_ret_t Msg32Prio_InitializeLevel(msg32_prio_t* p, uint8_t level, uint32_t* buf_ptr, uint16_t buf_size);
+
+// write data to level
+msg32_ret_t Msg32Prio_WriteData(msg32_prio_t* p, uint8_t level, uint32_t data);
+
+// read data from the highest non-empty level, level_ptr - source level (can be NULL)
+msg32_ret_t Msg32Prio_ReadData(msg32_prio_t* p, uint32_t* data_ptr, uint8_t* level_ptr);
+
+// write in thread safe mode
+msg32_ret_t Msg32Prio_WriteDataProtected(msg32_prio_t* p, uint8_t level, uint32_t data);
+
+// read in thread safe mode
+msg32_ret_t Msg32Prio_ReadDataProtected(msg32_prio_t* p, uint32_t* data_ptr, uint8_t* level_ptr);
+
+// get number of elements in all levels
+uint32_t Msg32Prio_GetCount(msg32_prio_t* p);
+
+
+
+#endif /* CIRCBUF_MSG32_PRIO_H_ */
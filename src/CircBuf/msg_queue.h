@@ -0,0 +1,142 @@
+/**************************************************************************//**
+ * @file      msg_queue.h
+ * @brief     Generator of typed message queues. Header file.
+ * @version   V1.0.00
+ * @date      19.10.2026
+ ******************************************************************************/
+/*
+* Copyright 2024 Yury A. Kuzishchin and Vitaly A. Kostarev. All rights reserved.
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+*/
+
+#ifndef CIRCBUF_MSG_QUEUE_H_
+#define CIRCBUF_MSG_QUEUE_H_
+
+
+#include "msg32.h"                          // return codes
+#include "Platform/compiler_macros.h"
+
+
+/*
+ * MSG_QUEUE_DEFINE(name, type, capacity) generates a queue of elements of any type:
+ *
+ *   name_t                                   queue type, storage is inside the structure
+ *   void        name_Init(name_t* p)
+ *   msg32_ret_t name_Write(name_t* p, const type* data)       single writer, lock-free
+ *   msg32_ret_t name_Read(name_t* p, type* data)              single reader, lock-free
+ *   msg32_ret_t name_WriteProtected(name_t* p, const type* data)
+ *   msg32_ret_t name_ReadProtected(name_t* p, type* data)
+ *   type*       name_Peek(name_t* p)         oldest element or NULL, removed by name_Drop
+ *   void        name_Drop(name_t* p)
+ *   uint32_t    name_GetCount(name_t* p)
+ *
+ * capacity must be a power of two (checked at compile time), elements are copied by assignment
+ * and indices are masked with a constant, so there is no size arithmetic per element.
+ * Indices are free running: the writer owns end_ind, the reader owns start_ind.
+ *
+ * Example:
+ *   typedef struct { uint8_t* ptr; uint16_t len; } tx_req_t;
+ *   MSG_QUEUE_DEFINE(TxQueue, tx_req_t, 16)
+ *   TxQueue_t tx_queue;
+ */
+#define MSG_QUEUE_DEFINE(name, type, capacity)                                              \
+                                                                                            \
+typedef char name##_capacity_must_be_pow2[(((capacity) > 0) &&                              \
+                                           (((capacity) & ((capacity) - 1)) == 0)) ? 1 : -1]; \
+                                                                                            \
+typedef struct                                                                              \
+{                                                                                           \
+	type buf[capacity];                     /* elements */                                  \
+	volatile uint32_t start_ind;            /* read index (reader) */                       \
+	volatile uint32_t end_ind;              /* write index (writer) */                      \
+                                                                                            \
+} name##_t;                                                                                 \
+                                                                                            \
+SFINLINE void name##_Init(name##_t* p)                                                      \
+{                                                                                           \
+	p->start_ind = 0;                                                                       \
+	p->end_ind = 0;                                                                         \
+}                                                                                           \
+                                                                                            \
+SFINLINE uint32_t name##_GetCount(name##_t* p)                                              \
+{                                                                                           \
+	return p->end_ind - p->start_ind;                                                       \
+}                                                                                           \
+                                                                                            \
+SFINLINE msg32_ret_t name##_Write(name##_t* p, const type* data)                            \
+{                                                                                           \
+	uint32_t end_ind = p->end_ind;                                                          \
+                                                                                            \
+	if(end_ind - p->start_ind >= (capacity))                                                \
+		return MSG32__OVF;                                                                  \
+                                                                                            \
+	MEM_BARRIER();                          /* slot is written after reader released it */  \
+	p->buf[end_ind & ((capacity) - 1)] = *data;                                             \
+	MEM_BARRIER();                          /* data is written before index is published */ \
+	p->end_ind = end_ind + 1;                                                               \
+                                                                                            \
+	return MSG32__OK;                                                                       \
+}                                                                                           \
+                                                                                            \
+SFINLINE type* name##_Peek(name##_t* p)                                                     \
+{                                                                                           \
+	uint32_t start_ind = p->start_ind;                                                      \
+                                                                                            \
+	if(p->end_ind == start_ind)                                                             \
+		return NULL;                                                                        \
+                                                                                            \
+	MEM_BARRIER();                          /* data is read after index */                  \
+	return &p->buf[start_ind & ((capacity) - 1)];                                           \
+}                                                                                           \
+                                                                                            \
+SFINLINE void name##_Drop(name##_t* p)                                                      \
+{                                                                                           \
+	MEM_BARRIER();                          /* data is read before slot is released */      \
+	p->start_ind = p->start_ind + 1;                                                        \
+}                                                                                           \
+                                                                                            \
+SFINLINE msg32_ret_t name##_Read(name##_t* p, type* data)                                   \
+{                                                                                           \
+	type* elem = name##_Peek(p);                                                            \
+                                                                                            \
+	if(elem == NULL)                                                                        \
+		return MSG32__EMPTY;                                                                \
+                                                                                            \
+	*data = *elem;                                                                          \
+	name##_Drop(p);                                                                         \
+                                                                                            \
+	return MSG32__OK;                                                                       \
+}                                                                                           \
+                                                                                            \
+SFINLINE msg32_ret_t name##_WriteProtected(name##_t* p, const type* data)                   \
+{                                                                                           \
+	uint32_t s;                                                                             \
+	ENTER_CRITICAL(s);                                                                      \
+	msg32_ret_t ret = name##_Write(p, data);                                                \
+	LEAVE_CRITICAL(s);                                                                      \
+	return ret;                                                                             \
+}                                                                                           \
+                                                                                            \
+SFINLINE msg32_ret_t name##_ReadProtected(name##_t* p, type* data)                          \
+{                                                                                           \
+	uint32_t s;                                                                             \
+	ENTER_CRITICAL(s);                                                                      \
+	msg32_ret_t ret = name##_Read(p, data);                                                 \
+	LEAVE_CRITICAL(s);                                                                      \
+	return ret;                                                                             \
+}
+
+
+
+#endif /* CIRCBUF_MSG_QUEUE_H_ */
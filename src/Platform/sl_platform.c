@@ -41,3 +41,17 @@ __weak uint32_t SL_GetTick_us()
 }
 
 
+// ожидание события
+__weak uint8_t SL_WaitEvent(volatile uint32_t *seq, uint32_t val, uint32_t timeout_ms)
+{
+	if(*seq == val)
+		SL_Delay(1);
+
+	return (*seq != val);
+}
+
+
+// сигнал события
+__weak void SL_SignalEvent(volatile uint32_t *seq){}
+
+
@@ -37,6 +37,14 @@ __weak void SL_Delay(uint32_t ms);
 // получть системное время в мкс
 __weak uint32_t SL_GetTick_us();
 
+// ожидание события: блокировать поток, пока *seq равно val, но не дольше timeout_ms (0xFFFFFFFF - без ограничения)
+// возвращает 1, если значение изменилось; ложные пробуждения допустимы (вызывающий проверяет условие сам)
+// по умолчанию - опрос с задержкой SL_Delay(1), для ОС и хоста переопределяется (семафор, futex, condvar)
+__weak uint8_t SL_WaitEvent(volatile uint32_t *seq, uint32_t val, uint32_t timeout_ms);
+
+// сигнал события: *seq уже изменено, разбудить потоки, ожидающие в SL_WaitEvent (может вызываться из прерывания)
+__weak void SL_SignalEvent(volatile uint32_t *seq);
+
 
 
 #endif /* APPLICATION_SUPPORTLIBS_PLATFORM_SL_PLATFORM_H_ */